@@ -1,7 +1,9 @@
 #version 330 core
 
+in vec4 vColor;
+
 out vec4 FragColor;
 
 void main() {
-    FragColor = vec4(1.0, 0.5, 0.2, 1.0);
+    FragColor = vColor;
 }
\ No newline at end of file
@@ -1,11 +1,22 @@
 #version 330 core
 
 layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aOffset;
+layout (location = 2) in float aRadius;
+layout (location = 3) in vec4 aColor;
+layout (location = 4) in vec2 aPreviousOffset;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+};
+uniform float interpolation;
+
+out vec4 vColor;
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    vColor = aColor;
+    vec2 offset = mix(aPreviousOffset, aOffset, interpolation);
+    gl_Position = viewProjection * vec4(aPos * aRadius + vec3(offset, 0.0), 1.0);
 }
\ No newline at end of file
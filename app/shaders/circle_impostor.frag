@@ -0,0 +1,18 @@
+#version 330 core
+
+in vec2 vLocal;
+in float vRadius;
+in vec4 vColor;
+
+uniform float pixelSize;
+
+out vec4 FragColor;
+
+void main() {
+    float signedDistance = length(vLocal) - vRadius;
+    float coverage = clamp(0.5 - signedDistance / pixelSize, 0.0, 1.0);
+    if (coverage <= 0.0) {
+        discard;
+    }
+    FragColor = vec4(vColor.rgb, vColor.a * coverage);
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#version 330 core
+
+layout (location = 0) in vec2 aCorner;
+layout (location = 1) in vec2 aOffset;
+layout (location = 2) in float aRadius;
+layout (location = 3) in vec4 aColor;
+layout (location = 4) in vec2 aPreviousOffset;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+};
+uniform float pixelSize;
+uniform float interpolation;
+
+out vec2 vLocal;
+out float vRadius;
+out vec4 vColor;
+
+void main() {
+    // Pad the quad by one pixel so the antialiased rim of even sub-pixel circles is rasterized
+    vLocal = aCorner * (aRadius + pixelSize);
+    vRadius = aRadius;
+    vColor = aColor;
+    vec2 offset = mix(aPreviousOffset, aOffset, interpolation);
+    gl_Position = viewProjection * vec4(offset + vLocal, 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,508 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <print>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "utilities/BarnesHut.h"
+#include "utilities/ConservationDiagnostics.h"
+#include "utilities/DynamicAabbTree.h"
+#include "utilities/FastMultipole.h"
+#include "utilities/Integrator.h"
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+#include "utilities/SweepAndPrune.h"
+#include "utilities/UniformGrid.h"
+#include "utilities/broadphase.h"
+#include "utilities/forces.h"
+
+// Bound on a disc of particles in near-circular orbits around the origin
+csv::ParticleSystem makeDisc(const std::size_t count)
+{
+    csv::ParticleSystem particles{ count };
+    const auto mass{ 1.0f / static_cast<float>(count) };
+    for (const auto index : std::views::iota(0uz, count))
+    {
+        // Golden-angle spiral gives an even, deterministic fill of the unit disc
+        const auto radius{ std::sqrt((static_cast<float>(index) + 0.5f) / static_cast<float>(count)) };
+        const auto angle{ static_cast<float>(index) * std::numbers::pi_v<float> * (3.0f - std::sqrt(5.0f)) };
+        const glm::vec2 direction{ std::cos(angle), std::sin(angle) };
+        particles.add({
+            .position = radius * direction,
+            .velocity = 0.5f * std::sqrt(radius) * glm::vec2{ -direction.y, direction.x },
+            .mass = mass,
+            .radius = 0.01f
+        });
+    }
+    return particles;
+}
+
+// Particles scattered uniformly over the unit square, covering about areaFraction of it. Radii are spread
+// log-uniformly over a factor of radiusRatio; a ratio of 1 gives equal radii
+csv::ParticleSystem makeGas(const std::size_t count, const float areaFraction, const float radiusRatio = 1.0f)
+{
+    csv::ParticleSystem particles{ count };
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<float> coordinate{ 0.0f, 1.0f };
+    std::uniform_real_distribution<float> logRadius{ 0.0f, std::log(radiusRatio) };
+    std::normal_distribution<float> speed{ 0.0f, 0.1f };
+    for ([[maybe_unused]] const auto index : std::views::iota(0uz, count))
+    {
+        particles.add({
+            .position = { coordinate(generator), coordinate(generator) },
+            .velocity = { speed(generator), speed(generator) },
+            .radius = std::exp(logRadius(generator))
+        });
+    }
+
+    auto area{ 0.0 };
+    for (const auto radius : particles.getRadii())
+    {
+        area += std::numbers::pi * radius * radius;
+    }
+    const auto scale{ static_cast<float>(std::sqrt(areaFraction / area)) };
+    for (auto& radius : particles.getRadii())
+    {
+        radius *= scale;
+    }
+    return particles;
+}
+
+// Two rotating discs on a collision course, each with half of the particles
+csv::ParticleSystem makeGalaxyCollision(const std::size_t count)
+{
+    csv::ParticleSystem particles{ count };
+    for (const auto& [offset, drift] : { std::pair{ glm::vec2{ -1.5f, -0.3f }, glm::vec2{ 0.3f, 0.05f } },
+                                         std::pair{ glm::vec2{ 1.5f, 0.3f }, glm::vec2{ -0.3f, -0.05f } } })
+    {
+        const auto galaxy{ makeDisc(count / 2) };
+        for (const auto index : std::views::iota(0uz, galaxy.size()))
+        {
+            auto particle{ galaxy.get(index) };
+            particle.position += offset;
+            particle.velocity += drift;
+            particle.mass *= 0.5f;
+            particles.add(particle);
+        }
+    }
+    return particles;
+}
+
+template<csv::IntegrationScheme Scheme, csv::ForceLaw Force>
+void benchmarkIntegrator(const std::string_view forceName,
+                         const Force& force,
+                         const std::size_t particleCount,
+                         const std::size_t steps,
+                         const float deltaTime)
+{
+    auto particles{ makeDisc(particleCount) };
+    csv::Integrator<Scheme, Force> integrator{ force };
+    integrator.step(particles, 0.0f);
+    const auto initialEnergy{ integrator.getPotentialEnergy() + csv::computeKineticEnergy(particles) };
+
+    const auto start{ std::chrono::steady_clock::now() };
+    for ([[maybe_unused]] const auto step : std::views::iota(0uz, steps))
+    {
+        integrator.step(particles, deltaTime);
+    }
+    const std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+
+    const auto finalEnergy{ integrator.getPotentialEnergy() + csv::computeKineticEnergy(particles) };
+    std::println("{:<16} {:<14} {:>8} {:>8} {:>17.3f} {:>14.3e}",
+                 Scheme::NAME,
+                 forceName,
+                 particleCount,
+                 steps,
+                 elapsed.count() / static_cast<double>(particleCount * steps),
+                 std::abs((finalEnergy - initialEnergy) / initialEnergy));
+}
+
+template<csv::IntegrationScheme Scheme>
+void benchmarkScheme()
+{
+    benchmarkIntegrator<Scheme>("harmonic well", csv::HarmonicWell{}, 100'000, 1'000, 1e-2f);
+    benchmarkIntegrator<Scheme>("direct gravity", csv::DirectGravity{ 1.0f, 0.05f }, 1'000, 1'000, 1e-3f);
+}
+
+void benchmarkIntegrators()
+{
+    std::println("{:<16} {:<14} {:>8} {:>8} {:>17} {:>14}",
+                 "integrator", "force", "n", "steps", "ns/particle/step", "|dE/E0|");
+    benchmarkScheme<csv::VelocityVerlet>();
+    benchmarkScheme<csv::Leapfrog>();
+    benchmarkScheme<csv::ForestRuth>();
+}
+
+// Times findPairs() over a run of short drift steps, so incremental broadphases see realistic coherence
+template<csv::Broadphase Broadphase>
+void benchmarkBroadphase(const std::string_view name, const std::string_view scene, csv::ParticleSystem particles)
+{
+    constexpr auto STEPS{ 10uz };
+    constexpr auto DELTA_TIME{ 1e-3f };
+
+    Broadphase broadphase{};
+    std::vector<csv::CandidatePair> pairs{};
+    broadphase.findPairs(particles, pairs);
+
+    std::chrono::duration<double, std::milli> elapsed{};
+    for ([[maybe_unused]] const auto step : std::views::iota(0uz, STEPS))
+    {
+        const auto positions{ particles.getPositions() };
+        const auto velocities{ particles.getVelocities() };
+        for (const auto index : std::views::iota(0uz, particles.size()))
+        {
+            positions[index] += velocities[index] * DELTA_TIME;
+        }
+
+        const auto start{ std::chrono::steady_clock::now() };
+        broadphase.findPairs(particles, pairs);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+
+    std::println("{:<16} {:<12} {:>8} {:>10} {:>10.3f}",
+                 name, scene, particles.size(), pairs.size(), elapsed.count() / static_cast<double>(STEPS));
+}
+
+void benchmarkBroadphases()
+{
+    std::println("{:<16} {:<12} {:>8} {:>10} {:>10}", "broadphase", "scene", "n", "pairs", "ms/step");
+    for (const auto particleCount : { 10'000uz, 100'000uz, 1'000'000uz })
+    {
+        for (const auto& [scene, radiusRatio] : { std::pair{ "equal radii", 1.0f },
+                                                  std::pair{ "radii x100", 100.0f },
+                                                  std::pair{ "radii x10^4", 1e4f } })
+        {
+            const auto particles{ makeGas(particleCount, 0.3f, radiusRatio) };
+            benchmarkBroadphase<csv::UniformGrid>("uniform grid", scene, particles);
+            benchmarkBroadphase<csv::SweepAndPrune>("sweep and prune", scene, particles);
+            benchmarkBroadphase<csv::DynamicAabbTree>("AABB tree", scene, particles);
+        }
+    }
+}
+
+// Evaluates force once and returns the wall time in milliseconds
+template<csv::ForceLaw Force>
+double timeForce(Force& force, const csv::ParticleSystem& particles, std::span<glm::vec2> accelerations, double& potentialEnergy)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    potentialEnergy = force(particles, accelerations);
+    return std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+void benchmarkDirectGravity()
+{
+    // Conventional operation count of one softened interaction, including the reciprocal square root
+    constexpr auto FLOPS_PER_INTERACTION{ 20.0 };
+
+    std::println("{:<10} {:>8} {:>10} {:>10} {:>14} {:>10}",
+                 "accumulate", "n", "ms/eval", "GFLOP/s", "rms |da|/|a|", "bh ms/eval");
+    for (const auto count : { 1'000uz, 5'000uz, 20'000uz, 50'000uz })
+    {
+        const auto particles{ makeGalaxyCollision(count) };
+        std::vector<glm::vec2> reference(particles.size());
+        std::vector<glm::vec2> accelerations(particles.size());
+        const auto interactions{ static_cast<double>(particles.size()) * static_cast<double>(particles.size() - 1) };
+
+        // The approximate solver that direct summation competes with at this size
+        csv::BarnesHut barnesHut{};
+        auto potential{ 0.0 };
+        const auto barnesHutTime{ timeForce(barnesHut, particles, accelerations, potential) };
+
+        for (const auto accumulateInDouble : { true, false })
+        {
+            const csv::DirectGravity direct{ .accumulateInDouble = accumulateInDouble };
+            const auto time{ timeForce(direct, particles, accumulateInDouble ? reference : accelerations, potential) };
+
+            // Float accumulation is measured against double accumulation
+            auto squaredError{ 0.0 };
+            auto squaredReference{ 0.0 };
+            for (const auto index : std::views::iota(0uz, particles.size()))
+            {
+                const glm::dvec2 difference{ accelerations[index] - reference[index] };
+                squaredError += glm::dot(difference, difference);
+                squaredReference += glm::dot(glm::dvec2{ reference[index] }, glm::dvec2{ reference[index] });
+            }
+
+            std::println("{:<10} {:>8} {:>10.2f} {:>10.2f} {:>14} {:>10.2f}",
+                         accumulateInDouble ? "double" : "float",
+                         particles.size(),
+                         time,
+                         FLOPS_PER_INTERACTION * interactions / (time * 1e6),
+                         accumulateInDouble ? "-" : std::format("{:.3e}", std::sqrt(squaredError / squaredReference)),
+                         barnesHutTime);
+        }
+    }
+}
+
+void benchmarkBarnesHut()
+{
+    constexpr auto SOFTENING{ 0.01f };
+
+    // Accuracy against direct summation on a scene small enough to sum exactly
+    const auto particles{ makeGalaxyCollision(20'000) };
+    std::vector<glm::vec2> exact(particles.size());
+    std::vector<glm::vec2> approximate(particles.size());
+
+    csv::DirectGravity direct{ 1.0f, SOFTENING };
+    auto exactPotential{ 0.0 };
+    const auto directTime{ timeForce(direct, particles, exact, exactPotential) };
+
+    std::println("{:<10} {:>8} {:>10} {:>10} {:>9} {:>12} {:>12} {:>12}",
+                 "theta", "n", "nodes", "ms/eval", "speedup", "rms |da|/|a|", "p99 |da|/|a|", "|dU/U|");
+    std::println("{:<10} {:>8} {:>10} {:>10.2f} {:>9.1f} {:>12} {:>12} {:>12}",
+                 "direct", particles.size(), "-", directTime, 1.0, "-", "-", "-");
+    for (const auto openingAngle : { 0.2f, 0.3f, 0.5f, 0.7f, 1.0f })
+    {
+        csv::BarnesHut barnesHut{ openingAngle, 1.0f, SOFTENING };
+        auto potential{ 0.0 };
+        const auto time{ timeForce(barnesHut, particles, approximate, potential) };
+
+        std::vector<double> errors(particles.size());
+        auto squaredErrorSum{ 0.0 };
+        for (const auto index : std::views::iota(0uz, particles.size()))
+        {
+            errors[index] = glm::length(glm::dvec2{ approximate[index] - exact[index] }) / glm::length(glm::dvec2{ exact[index] });
+            squaredErrorSum += errors[index] * errors[index];
+        }
+        const auto percentile{ errors.begin() + static_cast<std::ptrdiff_t>(0.99 * static_cast<double>(errors.size())) };
+        std::ranges::nth_element(errors, percentile);
+
+        std::println("{:<10.2f} {:>8} {:>10} {:>10.2f} {:>9.1f} {:>12.3e} {:>12.3e} {:>12.3e}",
+                     openingAngle,
+                     particles.size(),
+                     barnesHut.getNodeCount(),
+                     time,
+                     directTime / time,
+                     std::sqrt(squaredErrorSum / static_cast<double>(errors.size())),
+                     *percentile,
+                     std::abs((potential - exactPotential) / exactPotential));
+    }
+
+    // Throughput at the target scale, where direct summation is out of reach
+    const auto galaxies{ makeGalaxyCollision(1'000'000) };
+    std::vector<glm::vec2> accelerations(galaxies.size());
+    for (const auto openingAngle : { 0.5f, 0.7f, 1.0f })
+    {
+        csv::BarnesHut barnesHut{ openingAngle, 1.0f, SOFTENING };
+        auto potential{ 0.0 };
+        const auto time{ timeForce(barnesHut, galaxies, accelerations, potential) };
+        std::println("{:<10.2f} {:>8} {:>10} {:>10.2f} {:>9} {:>12} {:>12} {:>12}",
+                     openingAngle, galaxies.size(), barnesHut.getNodeCount(), time, "-", "-", "-", "-");
+    }
+}
+
+// Same gas, with alternating unit charges so that it is neutral overall
+csv::ParticleSystem makePlasma(const std::size_t count)
+{
+    auto particles{ makeGas(count, 0.1f) };
+    for (const auto index : std::views::iota(0uz, particles.size()))
+    {
+        particles.getCharges()[index] = index % 2 == 0 ? 1.0f : -1.0f;
+    }
+    return particles;
+}
+
+void benchmarkFastMultipole()
+{
+    using Interaction = csv::FastMultipole::Interaction;
+    constexpr auto SAMPLE_COUNT{ 2'000uz };
+
+    // Accuracy against direct summation of the log kernel, at sampled particles
+    std::println("{:<10} {:>6} {:>8} {:>7} {:>10} {:>12} {:>12}",
+                 "kernel", "order", "n", "levels", "ms/eval", "rms |da|/a", "max |da|/a");
+    for (const auto& [name, interaction, particles] : { std::tuple{ "gravity", Interaction::Gravity, makeGalaxyCollision(20'000) },
+                                                        std::tuple{ "coulomb", Interaction::Coulomb, makePlasma(20'000) } })
+    {
+        std::vector<glm::vec2> accelerations(particles.size());
+        for (const auto order : { 4uz, 8uz, 12uz, 16uz, 20uz })
+        {
+            csv::FastMultipole fastMultipole{ { .interaction = interaction, .order = order, .softening = 0.0f } };
+            auto potential{ 0.0 };
+            const auto time{ timeForce(fastMultipole, particles, accelerations, potential) };
+            const auto error{ fastMultipole.measureError(particles, accelerations, SAMPLE_COUNT) };
+            std::println("{:<10} {:>6} {:>8} {:>7} {:>10.2f} {:>12.3e} {:>12.3e}",
+                         name, order, particles.size(), fastMultipole.getLevelCount(), time, error.rms, error.max);
+        }
+    }
+
+    // Throughput up to the target scale, where even sampled direct sums become slow
+    constexpr auto TOLERANCE{ 1e-6 };
+    for (const auto count : { 100'000uz, 1'000'000uz, 10'000'000uz })
+    {
+        const auto galaxies{ makeGalaxyCollision(count) };
+        std::vector<glm::vec2> accelerations(galaxies.size());
+        const auto order{ csv::FastMultipole::orderForTolerance(TOLERANCE) };
+        csv::FastMultipole fastMultipole{ { .order = order } };
+        auto potential{ 0.0 };
+        const auto time{ timeForce(fastMultipole, galaxies, accelerations, potential) };
+        std::println("{:<10} {:>6} {:>8} {:>7} {:>10.2f} {:>12} {:>12}",
+                     "gravity", order, galaxies.size(), fastMultipole.getLevelCount(), time, "-", "-");
+    }
+}
+
+// Milliseconds per call of function, averaged over repeats calls
+template<typename Function>
+double timeRepeated(const std::size_t repeats, const Function& function)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    for ([[maybe_unused]] const auto repeat : std::views::iota(0uz, repeats))
+    {
+        function();
+    }
+    return std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count()
+           / static_cast<double>(repeats);
+}
+
+void benchmarkJobSystem()
+{
+    csv::JobSystem jobSystem{};
+    std::println("{} workers plus the calling thread", jobSystem.getWorkerCount());
+
+    // Scheduling cost alone: a 10^6-element loop in 1k-element chunks of no work
+    constexpr auto JOB_COUNT{ 1'000uz };
+    const auto emptyTime{ timeRepeated(100, [&]
+    {
+        csv::parallelFor(&jobSystem, 0, JOB_COUNT * 1'000, 1'000, [](std::size_t, std::size_t) {});
+    }) };
+    std::println("{:<28} {:>10.1f} ns/job", "empty parallelFor", emptyTime * 1e6 / JOB_COUNT);
+
+    std::println("{:<28} {:>10} {:>10} {:>9} {:>10}", "workload", "serial ms", "jobs ms", "speedup", "identical");
+    const auto report{ [](const std::string_view name,
+                          const double serialTime,
+                          const double parallelTime,
+                          const bool identical)
+    {
+        std::println("{:<28} {:>10.2f} {:>10.2f} {:>9.2f} {:>10}",
+                     name, serialTime, parallelTime, serialTime / parallelTime, identical ? "yes" : "no");
+    } };
+
+    // Each solver is run once without and once with the job system, and the outputs are compared bit for bit
+    const auto compareForce{ [&](const std::string_view name, auto& force, const csv::ParticleSystem& particles)
+    {
+        std::vector<glm::vec2> serial(particles.size());
+        std::vector<glm::vec2> parallel(particles.size());
+        auto serialPotential{ 0.0 };
+        auto parallelPotential{ 0.0 };
+        force.setJobSystem(nullptr);
+        const auto serialTime{ timeForce(force, particles, serial, serialPotential) };
+        force.setJobSystem(&jobSystem);
+        const auto parallelTime{ timeForce(force, particles, parallel, parallelPotential) };
+        report(name, serialTime, parallelTime, serial == parallel && serialPotential == parallelPotential);
+    } };
+
+    {
+        const auto particles{ makeGalaxyCollision(20'000) };
+        csv::DirectGravity serialDirect{};
+        csv::DirectGravity parallelDirect{ .jobSystem = &jobSystem };
+        std::vector<glm::vec2> serial(particles.size());
+        std::vector<glm::vec2> parallel(particles.size());
+        auto serialPotential{ 0.0 };
+        auto parallelPotential{ 0.0 };
+        const auto serialTime{ timeForce(serialDirect, particles, serial, serialPotential) };
+        const auto parallelTime{ timeForce(parallelDirect, particles, parallel, parallelPotential) };
+        report("direct gravity 2x10^4",
+               serialTime,
+               parallelTime,
+               serial == parallel && serialPotential == parallelPotential);
+    }
+
+    const auto galaxies{ makeGalaxyCollision(1'000'000) };
+    csv::BarnesHut barnesHut{};
+    compareForce("barnes-hut 10^6", barnesHut, galaxies);
+    csv::FastMultipole fastMultipole{};
+    compareForce("fast multipole 10^6", fastMultipole, galaxies);
+
+    {
+        // Leapfrog over the harmonic well, whose force pass is as cheap as the sweeps, so the sweeps dominate
+        auto serialParticles{ galaxies };
+        auto parallelParticles{ galaxies };
+        csv::Integrator<csv::Leapfrog, csv::HarmonicWell> serialIntegrator{};
+        csv::Integrator<csv::Leapfrog, csv::HarmonicWell> parallelIntegrator{};
+        parallelIntegrator.setJobSystem(&jobSystem);
+        const auto serialTime{ timeRepeated(10, [&] { serialIntegrator.step(serialParticles, 1e-3f); }) };
+        const auto parallelTime{ timeRepeated(10, [&] { parallelIntegrator.step(parallelParticles, 1e-3f); }) };
+        report("leapfrog sweeps 10^6",
+               serialTime,
+               parallelTime,
+               std::ranges::equal(serialParticles.getPositions(), parallelParticles.getPositions())
+               && std::ranges::equal(serialParticles.getVelocities(), parallelParticles.getVelocities()));
+    }
+
+    {
+        csv::ConservationDiagnostics serialDiagnostics{};
+        csv::ConservationDiagnostics parallelDiagnostics{};
+        parallelDiagnostics.setJobSystem(&jobSystem);
+        const auto serialTime{ timeRepeated(10, [&] { serialDiagnostics.record(galaxies, 0.0, 0.0); }) };
+        const auto parallelTime{ timeRepeated(10, [&] { parallelDiagnostics.record(galaxies, 0.0, 0.0); }) };
+        const auto serialSample{ *serialDiagnostics.getHistory().latest() };
+        const auto parallelSample{ *parallelDiagnostics.getHistory().latest() };
+        report("diagnostics 10^6",
+               serialTime,
+               parallelTime,
+               serialSample.totalEnergy == parallelSample.totalEnergy
+               && serialSample.linearMomentum == parallelSample.linearMomentum
+               && serialSample.angularMomentum == parallelSample.angularMomentum);
+    }
+
+    {
+        const auto gas{ makeGas(1'000'000, 0.3f) };
+        csv::UniformGrid grid{};
+        std::vector<csv::CandidatePair> serial{};
+        std::vector<csv::CandidatePair> parallel{};
+        const auto serialTime{ timeRepeated(5, [&] { grid.findPairs(gas, serial); }) };
+        grid.setJobSystem(&jobSystem);
+        const auto parallelTime{ timeRepeated(5, [&] { grid.findPairs(gas, parallel); }) };
+        const auto samePair{ [](const csv::CandidatePair& first, const csv::CandidatePair& second)
+        {
+            return first.first == second.first && first.second == second.second;
+        } };
+        const auto identical{ std::ranges::equal(serial, parallel, samePair) };
+        report("uniform grid 10^6", serialTime, parallelTime, identical);
+    }
+}
+
+int main(const int argc, const char* argv[])
+{
+    // Runs every benchmark, or only those named on the command line
+    const auto selected{ [&](const std::string_view name)
+    {
+        const std::span arguments{ argv + 1, argv + argc };
+        return arguments.empty() || std::ranges::find(arguments, name) != arguments.end();
+    } };
+
+    if (selected("integrators"))
+    {
+        benchmarkIntegrators();
+    }
+    if (selected("direct"))
+    {
+        benchmarkDirectGravity();
+    }
+    if (selected("barnes-hut"))
+    {
+        benchmarkBarnesHut();
+    }
+    if (selected("fmm"))
+    {
+        benchmarkFastMultipole();
+    }
+    if (selected("broadphase"))
+    {
+        benchmarkBroadphases();
+    }
+    if (selected("jobs"))
+    {
+        benchmarkJobSystem();
+    }
+
+    return 0;
+}
@@ -1,14 +1,35 @@
 #include <algorithm>
-#include <cmath>
-#include <concepts>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <print>
 #include <ranges>
-#include <vector>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
 
 #include "utilities/Camera.h"
+#include "utilities/CircleRenderer.h"
+#include "utilities/ConservationDiagnostics.h"
+#include "utilities/GlState.h"
+#include "utilities/GpuTimer.h"
+#include "utilities/Integrator.h"
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
 #include "utilities/ShaderProgram.h"
+#include "utilities/ShaderWatcher.h"
+#include "utilities/SimulationThread.h"
+#include "utilities/TaskGraph.h"
+#include "utilities/WindowEvents.h"
 
 constexpr auto INITIAL_WINDOW_WIDTH{ 800 };
 constexpr auto INITIAL_WINDOW_HEIGHT{ 600 };
@@ -16,33 +37,264 @@ constexpr auto INITIAL_WINDOW_HEIGHT{ 600 };
 float currentWindowWidth{ INITIAL_WINDOW_WIDTH };
 float currentWindowHeight{ INITIAL_WINDOW_HEIGHT };
 
-// Generate circle vertices
-template<std::floating_point T, std::size_t Segments>
-constexpr std::array<T, 3 * (Segments + 2)> generateCircle(const T radius)
-{
-    std::array<T, 3 * (Segments + 2)> vertices{};
-    constexpr auto tau{ static_cast<T>(2) * std::numbers::pi_v<T> };
+// Physics steps per second, independent of the display refresh rate
+constexpr auto SIMULATION_RATE{ 240.0 };
+
+// Circles copied into the instance buffers per job
+constexpr std::size_t STAGING_GRAIN{ 4096 };
+
+// Written when G is pressed; render with Graphviz, e.g. dot -Tsvg frame_graph.dot
+constexpr auto FRAME_GRAPH_FILE{ "frame_graph.dot" };
 
-    for (const auto index : std::views::iota(0uz, Segments + 1))
+// Lay out a grid of small particles covering the initial view
+void populateParticleGrid(csv::ParticleSystem& particles, const std::size_t columns, const std::size_t rows)
+{
+    particles.reserve(particles.size() + columns * rows);
+    const auto spacing{ 2.0f / static_cast<float>(std::max(columns, rows)) };
+    for (const auto row : std::views::iota(0uz, rows))
     {
-        const auto theta{ tau * static_cast<T>(index) / static_cast<T>(Segments) };
-        vertices[3 + index * 3 + 0] = radius * std::cos(theta);
-        vertices[3 + index * 3 + 1] = radius * std::sin(theta);
-        vertices[3 + index * 3 + 2] = static_cast<T>(0);
+        for (const auto column : std::views::iota(0uz, columns))
+        {
+            const auto u{ static_cast<float>(column) / static_cast<float>(columns - 1) };
+            const auto v{ static_cast<float>(row) / static_cast<float>(rows - 1) };
+            const glm::vec2 position{ (static_cast<float>(column) - static_cast<float>(columns - 1) / 2.0f) * spacing,
+                                      (static_cast<float>(row) - static_cast<float>(rows - 1) / 2.0f) * spacing };
+            particles.add({
+                .position = position,
+                .velocity = 0.25f * glm::vec2{ -position.y, position.x },
+                .radius = 0.4f * spacing,
+                .color = { 1.0f, 0.5f * (u + v), 0.2f + 0.6f * u, 1.0f }
+            });
+        }
     }
-    return vertices;
 }
 
-void processInput(GLFWwindow* window)
+void processInput(GLFWwindow* window, const csv::FrameEvents& events, csv::CircleRenderer& circleRenderer)
 {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    if (events.wasKeyPressed(GLFW_KEY_ESCAPE))
     {
         glfwSetWindowShouldClose(window, GLFW_TRUE);
+        // Wakes the main thread if it is waiting for events while this runs on the render thread
+        glfwPostEmptyEvent();
+    }
+
+    // Toggle between tessellated and analytic circles on each press of M
+    if (events.wasKeyPressed(GLFW_KEY_M))
+    {
+        circleRenderer.setMode(circleRenderer.getMode() == csv::CircleRenderer::Mode::Mesh
+                                   ? csv::CircleRenderer::Mode::Impostor
+                                   : csv::CircleRenderer::Mode::Mesh);
+    }
+}
+
+void reportFrameStatistics(const csv::GpuTimer& gpuTimer,
+                           const csv::GlState::Counters& glCounters,
+                           const csv::ConservationDiagnostics& diagnostics,
+                           const std::span<const csv::TaskGraph::TaskTiming> frameTasks)
+{
+    for (const auto& pass : gpuTimer.getResults())
+    {
+        std::println("{:>10}: GPU {:7.3f} ms, CPU {:7.3f} ms", pass.name, pass.gpuMilliseconds, pass.cpuMilliseconds);
+    }
+    std::println("{:>10}: {} issued, {} skipped", "GL state", glCounters.issued, glCounters.skipped);
+    // Critical path marked with an asterisk
+    for (const auto& task : frameTasks)
+    {
+        std::println("{:>10}: {:7.3f} - {:7.3f} ms{}",
+                     task.name,
+                     task.startMilliseconds,
+                     task.finishMilliseconds,
+                     task.isCritical ? " *" : "");
+    }
+    if (const auto sample{ diagnostics.getHistory().latest() })
+    {
+        std::println("{:>10}: E {:.9e} (drift {:+.3e}), L {:.9e}",
+                     "step " + std::to_string(sample->step),
+                     sample->totalEnergy,
+                     sample->relativeEnergyDrift,
+                     sample->angularMomentum);
     }
 }
 
-int main()
+void writeFrameGraph(const csv::TaskGraph& frameGraph, const std::filesystem::path& path)
 {
+    std::ofstream file{ path };
+    file << frameGraph.toDot();
+    std::println("Wrote the last frame's task graph to {}", path.string());
+}
+
+// Creates the GL resources and draws until the window should close or a stop is requested. The window's context
+// must not be current on any other thread. When pollEvents is false another thread is pumping GLFW events
+int runRenderLoop(GLFWwindow* window,
+                  csv::WindowEvents& windowEvents,
+                  const glm::ivec2& framebufferSize,
+                  const std::stop_token& stopToken,
+                  const bool pollEvents)
+{
+    glfwMakeContextCurrent(window);
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+    {
+        std::println(stderr, "Failed to initialize GLAD.");
+        return EXIT_FAILURE;
+    }
+
+    csv::CameraSystem cameraSystem{ framebufferSize };
+
+    const std::array<csv::ShaderProgramFiles, 2> circleProgramFiles{ {
+        { "shaders/circle.vert", "shaders/circle.frag" },
+        { "shaders/circle_impostor.vert", "shaders/circle_impostor.frag" }
+    } };
+    auto circlePrograms{ csv::ShaderProgram::loadBatch(circleProgramFiles) };
+    csv::CircleRenderer circleRenderer{ circlePrograms[0].get(), circlePrograms[1].get() };
+
+    csv::ShaderWatcher shaderWatcher{ "shaders" };
+    shaderWatcher.watch(circleRenderer.getProgram(csv::CircleRenderer::Mode::Mesh), circleProgramFiles[0]);
+    shaderWatcher.watch(circleRenderer.getProgram(csv::CircleRenderer::Mode::Impostor), circleProgramFiles[1]);
+
+    csv::ParticleSystem particles{};
+    populateParticleGrid(particles, 100, 100);
+
+    csv::GpuTimer gpuTimer{};
+    auto nextReportTime{ glfwGetTime() + 1.0 };
+
+    // One pool for the simulation and the frame graph; a thread waiting on its jobs only ever runs its own, so the
+    // simulation thread never picks up frame work and this thread never picks up simulation work
+    csv::JobSystem jobSystem{};
+
+    // Touched only by the simulation thread once it starts; the diagnostics history is safe to read from here
+    csv::Integrator<csv::Leapfrog, csv::HarmonicWell> integrator{};
+    integrator.setJobSystem(&jobSystem);
+    csv::ConservationDiagnostics diagnostics{};
+    diagnostics.setJobSystem(&jobSystem);
+    auto simulationTime{ 0.0 };
+
+    csv::SimulationThread simulation{
+        std::move(particles),
+        [&](csv::ParticleSystem& simulatedParticles, const float stepSeconds)
+        {
+            integrator.step(simulatedParticles, stepSeconds);
+            simulationTime += stepSeconds;
+            diagnostics.record(simulatedParticles, integrator.getPotentialEnergy(), simulationTime);
+        },
+        1.0 / SIMULATION_RATE
+    };
+
+    // Each frame runs as a task graph: GL work stays on this thread, the rest overlaps with it on the job system.
+    // Every field is written by one task and read only by tasks that depend on it
+    struct Frame
+    {
+        csv::GlState::Counters glCounters{};
+        const csv::SimulationSnapshot* snapshot{};
+        csv::CircleStaging staging{};
+    } frame{};
+
+    using Affinity = csv::TaskGraph::Affinity;
+    using Task = csv::TaskGraph::Task;
+    csv::TaskGraph frameGraph{ &jobSystem };
+
+    const auto input{ frameGraph.add("input", Affinity::Context, [&]() -> Task
+    {
+        gpuTimer.beginFrame();
+        frame.glCounters = csv::GlState::beginFrame();
+
+        // Everything GLFW reported since the last frame; a resize storm becomes one viewport and projection update
+        const auto& events{ windowEvents.drain() };
+        if (events.framebufferSize)
+        {
+            cameraSystem.resize(*events.framebufferSize);
+        }
+        processInput(window, events, circleRenderer);
+        if (events.wasKeyPressed(GLFW_KEY_G))
+        {
+            writeFrameGraph(frameGraph, FRAME_GRAPH_FILE);
+        }
+
+        shaderWatcher.update();
+        cameraSystem.update();
+        co_return;
+    }) };
+
+    // Reads what input collected for the GPU timer and GL state, and the previous frame's graph timings
+    frameGraph.add("report", Affinity::Any, [&]() -> Task
+    {
+        if (glfwGetTime() >= nextReportTime)
+        {
+            reportFrameStatistics(gpuTimer, frame.glCounters, diagnostics, frameGraph.getTimings());
+            nextReportTime += 1.0;
+        }
+        co_return;
+    }, { input });
+
+    // Whatever the simulation finished last; staged straight from the snapshot without another copy. A context task,
+    // since the snapshot's single reader must always be the same thread
+    const auto snapshot{ frameGraph.add("snapshot", Affinity::Context, [&]() -> Task
+    {
+        frame.snapshot = &simulation.getLatestSnapshot();
+        co_return;
+    }) };
+
+    // Claims this frame's instance buffers with GL, then fills them on the workers
+    const auto stage{ frameGraph.add("stage", Affinity::Context, [&]() -> Task
+    {
+        const auto& latest{ *frame.snapshot };
+        frame.staging = circleRenderer.stage(latest.positions.size(), !latest.previousPositions.empty());
+        frame.staging.interpolation = latest.getInterpolation(std::chrono::steady_clock::now());
+
+        co_await frameGraph.resumeOn(Affinity::Any);
+        const csv::CircleInstances instances{ latest.positions, latest.radii, latest.colors, latest.previousPositions };
+        csv::parallelFor(&jobSystem,
+                         0,
+                         instances.size(),
+                         STAGING_GRAIN,
+                         [&](const std::size_t begin, const std::size_t end)
+                         {
+                             frame.staging.fill(instances, begin, end);
+                         });
+    }, { snapshot }) };
+
+    const auto draw{ frameGraph.add("draw", Affinity::Context, [&]() -> Task
+    {
+        {
+            csv::GpuTimer::Scope scope{ gpuTimer, "clear" };
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        {
+            csv::GpuTimer::Scope scope{ gpuTimer, "circles" };
+            circleRenderer.drawStaged(frame.staging, cameraSystem.getCamera());
+        }
+        co_return;
+    }, { input, stage }) };
+
+    frameGraph.add("swap", Affinity::Context, [&]() -> Task
+    {
+        glfwSwapBuffers(window);
+        if (pollEvents)
+        {
+            glfwPollEvents();
+        }
+        co_return;
+    }, { draw });
+
+    while (!stopToken.stop_requested() && !glfwWindowShouldClose(window))
+    {
+        frameGraph.run();
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int main(const int argc, const char* argv[])
+{
+    // With --render-thread the main thread only pumps GLFW events, so a window drag or resize that blocks event
+    // processing no longer stalls drawing
+    const std::span arguments{ argv + 1, argv + argc };
+    const auto useRenderThread{
+        std::ranges::find(arguments, std::string_view{ "--render-thread" }) != arguments.end()
+    };
+
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -68,70 +320,52 @@ int main()
         glfwTerminate();
         return EXIT_FAILURE;
     }
-    glfwMakeContextCurrent(window);
 
-    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+    // Callbacks must be installed and the framebuffer queried from the main thread. Sizes reported after the query
+    // reach the renderer through the event queue
+    csv::WindowEvents windowEvents{ window };
+    glm::ivec2 framebufferSize{};
+    glfwGetFramebufferSize(window, &framebufferSize.x, &framebufferSize.y);
+
+    auto exitCode{ EXIT_SUCCESS };
+    if (!useRenderThread)
     {
-        std::println(stderr, "Failed to initialize GLAD.");
-        return EXIT_FAILURE;
+        exitCode = runRenderLoop(window, windowEvents, framebufferSize, {}, true);
     }
-
-    csv::CameraSystem cameraSystem{ window };
-
-    constexpr auto segmentSize{ 100 };
-    const auto vertices{ generateCircle<float, segmentSize>(0.5f) };
-
-    const auto circleShader{ csv::ShaderProgram::load("shaders/circle.vert", "shaders/circle.frag") };
-
-    GLuint vertexArrayObject{};
-    glGenVertexArrays(1, &vertexArrayObject);
-
-    GLuint vertexBufferObject{};
-    glGenBuffers(1, &vertexBufferObject);
-
-    glBindVertexArray(vertexArrayObject);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vertexBufferObject);
-    glBufferData(GL_ARRAY_BUFFER,
-                 sizeof(std::ranges::range_value_t<decltype(vertices)>) * vertices.size(),
-                 vertices.data(),
-                 GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0,
-                          3,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          3 * sizeof(std::ranges::range_value_t<decltype(vertices)>),
-                          nullptr);
-    glEnableVertexAttribArray(0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    while (!glfwWindowShouldClose(window))
+    else
     {
-        cameraSystem.update();
-
-        processInput(window);
-
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        std::atomic_bool isRenderLoopFinished{ false };
+        std::exception_ptr renderError{};
+        std::jthread renderThread{ [&](const std::stop_token& stopToken)
+        {
+            try
+            {
+                exitCode = runRenderLoop(window, windowEvents, framebufferSize, stopToken, false);
+            }
+            catch (...)
+            {
+                renderError = std::current_exception();
+            }
+            glfwMakeContextCurrent(nullptr);
+            isRenderLoopFinished.store(true, std::memory_order_release);
+            glfwPostEmptyEvent();
+        } };
 
-        circleShader.use();
-        glBindVertexArray(vertexArrayObject);
-        circleShader.setUniform("model", cameraSystem.getCamera().getModelMatrix());
-        circleShader.setUniform("view", cameraSystem.getCamera().getViewMatrix());
-        circleShader.setUniform("projection", cameraSystem.getCamera().getProjectionMatrix());
-        glDrawArrays(GL_TRIANGLE_FAN, 0, segmentSize + 2);
+        while (!glfwWindowShouldClose(window) && !isRenderLoopFinished.load(std::memory_order_acquire))
+        {
+            glfwWaitEvents();
+        }
+        renderThread.request_stop();
+        renderThread.join();
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        if (renderError)
+        {
+            glfwTerminate();
+            std::rethrow_exception(renderError);
+        }
     }
 
-    glDeleteVertexArrays(1, &vertexArrayObject);
-    glDeleteBuffers(1, &vertexBufferObject);
-
     glfwTerminate();
 
-    return 0;
+    return exitCode;
 }
@@ -0,0 +1,56 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_ALIGNEDALLOCATOR_H
+#define CONSERVATION_UTILITIES_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace csv
+{
+    // Cache line size assumed when laying out hot data
+    inline constexpr std::size_t CACHE_LINE_SIZE{ 64 };
+
+    // Allocator that places every allocation on an Alignment-byte boundary
+    template<typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+    class AlignedAllocator
+    {
+    public:
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0);
+
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        constexpr explicit AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+        {
+        }
+
+        [[nodiscard]] T* allocate(const std::size_t count)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+        }
+
+        void deallocate(T* pointer, const std::size_t count) noexcept
+        {
+            ::operator delete(pointer, count * sizeof(T), std::align_val_t{ Alignment });
+        }
+
+        template<typename U>
+        constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+        {
+            return true;
+        }
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_ALIGNEDALLOCATOR_H
@@ -0,0 +1,98 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_BARNESHUT_H
+#define CONSERVATION_UTILITIES_BARNESHUT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+
+namespace csv
+{
+    // Barnes-Hut approximation of softened Newtonian gravity in O(n log n). The quadtree is rebuilt on every
+    // evaluation: particles are sorted by Morton code, cells are cut out of the sorted order breadth first into
+    // a flat node array, and masses are accumulated bottom up. Particles are then traversed in Morton order so
+    // that consecutive traversals touch the same nodes. Satisfies ForceLaw
+    class BarnesHut
+    {
+    public:
+        // Particles per leaf before a cell is split
+        static constexpr std::uint32_t LEAF_SIZE{ 8 };
+
+        // Morton codes hold 16 bits per axis, which bounds the tree depth
+        static constexpr std::uint32_t MAX_DEPTH{ 16 };
+
+        // A cell of width s at distance d is treated as a point mass when s / d < openingAngle, unless it contains
+        // the particle being evaluated; zero is exact
+        explicit BarnesHut(float openingAngle = 0.5f,
+                           float gravitationalConstant = 1.0f,
+                           float softening = 0.01f) noexcept;
+
+        double operator()(const ParticleSystem& particles, std::span<glm::vec2> accelerations);
+
+        void setOpeningAngle(float openingAngle) noexcept;
+
+        // Spreads the sort, the tree build and the traversal across worker threads; null runs everything on the caller
+        void setJobSystem(JobSystem* jobSystem) noexcept;
+
+        [[nodiscard]] float getOpeningAngle() const noexcept;
+
+        [[nodiscard]] std::size_t getNodeCount() const noexcept;
+
+    private:
+        struct Node
+        {
+            glm::vec2 centerOfMass;
+            float mass;
+            // Edge length of the cell
+            float size;
+            // Children are stored contiguously; a leaf has none
+            std::uint32_t firstChild;
+            std::uint32_t childCount;
+            // Range of the cell's particles in Morton order
+            std::uint32_t begin;
+            std::uint32_t end;
+        };
+
+        float m_openingAngle;
+        float m_gravitationalConstant;
+        float m_softening;
+        JobSystem* m_jobSystem{ nullptr };
+
+        // Morton code in the high half, particle index in the low half
+        std::vector<std::uint64_t> m_keys{};
+        std::vector<std::uint64_t> m_scratchKeys{};
+        std::vector<std::uint32_t> m_sortedCodes{};
+        AlignedVector<glm::vec2> m_sortedPositions{};
+        AlignedVector<float> m_sortedMasses{};
+        AlignedVector<glm::vec2> m_sortedAccelerations{};
+        std::vector<Node> m_nodes{};
+        // First node of each level, then the node count
+        std::vector<std::size_t> m_levelStarts{};
+
+        // Build scratch: digit write offsets per block of keys, and per cell of the level being split its quadrant
+        // boundaries and, offset by one, its child count prefix
+        std::vector<std::array<std::uint32_t, 256>> m_digitOffsets{};
+        std::vector<std::array<std::uint32_t, 5>> m_quadrantBounds{};
+        std::vector<std::uint32_t> m_childOffsets{};
+
+        void sortByMortonCode(const ParticleSystem& particles);
+
+        void buildNodes(float rootSize);
+
+        void accumulateMasses();
+
+        // Acceleration on the particle in sorted slot, without the gravitational constant; returns the potential
+        // per unit mass, also without it
+        float traverse(std::uint32_t slot, glm::vec2& acceleration) const noexcept;
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_BARNESHUT_H
@@ -5,9 +5,11 @@
 #ifndef CONSERVATION_UTILITIES_CAMERA_H
 #define CONSERVATION_UTILITIES_CAMERA_H
 
+#include <cstdint>
 #include <memory>
-#include <GLFW/glfw3.h>
+#include <glad/glad.h>
 #include <glm/matrix.hpp>
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
 namespace csv
@@ -28,6 +30,11 @@ namespace csv
 
         [[nodiscard]] glm::mat4 getProjectionMatrix() const noexcept;
 
+        [[nodiscard]] glm::mat4 getViewProjectionMatrix() const noexcept;
+
+        // Incremented whenever the view or projection changes
+        [[nodiscard]] std::uint64_t getRevision() const noexcept;
+
         void setPosition(const glm::vec3& position) noexcept;
 
         void setTarget(const glm::vec3& target) noexcept;
@@ -41,6 +48,13 @@ namespace csv
                                        float nearPlane,
                                        float farPlane) noexcept;
 
+        void setViewportSize(const glm::ivec2& viewportSize) noexcept;
+
+        [[nodiscard]] glm::ivec2 getViewportSize() const noexcept;
+
+        // Height of one framebuffer pixel in world units
+        [[nodiscard]] float getPixelSize() const noexcept;
+
     private:
         void updateProjectionMatrix() noexcept;
 
@@ -55,25 +69,51 @@ namespace csv
         float m_near;
         float m_far;
 
+        glm::ivec2 m_viewportSize{ 1, 1 };
+
         glm::mat4 m_projectionMatrix{};
+
+        std::uint64_t m_revision{};
     };
 
     class CameraSystem
     {
     public:
-        explicit CameraSystem(GLFWwindow* window);
+        // Needs a current GL context but nothing from GLFW, so it can live on a render thread; later framebuffer
+        // sizes arrive through resize()
+        explicit CameraSystem(const glm::ivec2& framebufferSize);
+
+        CameraSystem(const CameraSystem& other) = delete;
+        CameraSystem(CameraSystem&& other) noexcept = delete;
+        CameraSystem& operator=(const CameraSystem& other) = delete;
+        CameraSystem& operator=(CameraSystem&& other) noexcept = delete;
+
+        ~CameraSystem();
 
+        // Uploads the camera uniform block if the camera changed since the last upload
         void update() noexcept;
 
+        // Sets the viewport and an aspect-preserving projection for a framebuffer of the given size
+        void resize(const glm::ivec2& framebufferSize) const noexcept;
+
         [[nodiscard]] Camera& getCamera() noexcept;
 
         [[nodiscard]] const Camera& getCamera() const noexcept;
 
     private:
-        void onWindowResize(int width, int height) const noexcept;
+        // std140 layout of the Camera uniform block
+        struct CameraUniforms
+        {
+            glm::mat4 view;
+            glm::mat4 projection;
+            glm::mat4 viewProjection;
+        };
 
-        GLFWwindow* m_window;
         std::unique_ptr<Camera> m_camera;
+        GLuint m_uniformBuffer{};
+        std::uint64_t m_uploadedRevision{};
+
+        void uploadUniforms() const noexcept;
     };
 } // lgl
 
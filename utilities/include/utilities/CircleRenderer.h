@@ -0,0 +1,106 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_CIRCLERENDERER_H
+#define CONSERVATION_UTILITIES_CIRCLERENDERER_H
+
+#include <cstddef>
+#include <span>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "utilities/Camera.h"
+#include "utilities/GpuRingBuffer.h"
+#include "utilities/ShaderProgram.h"
+
+namespace csv
+{
+    // Per-instance attribute streams, one element per circle in each span
+    struct CircleInstances
+    {
+        std::span<const glm::vec2> positions;
+        std::span<const float> radii;
+        std::span<const glm::vec4> colors;
+        // Positions at the previous simulation step; when empty the circles are drawn at positions
+        std::span<const glm::vec2> previousPositions{};
+        // Blend factor from previousPositions (0) to positions (1)
+        float interpolation{ 1.0f };
+
+        [[nodiscard]] std::size_t size() const noexcept;
+    };
+
+    // This frame's regions of the instance buffers, claimed by CircleRenderer::stage. Unlike the GL calls around
+    // them, the regions can be filled from any thread, as long as that finishes before CircleRenderer::drawStaged
+    struct CircleStaging
+    {
+        std::span<std::byte> positions;
+        // Empty when the circles are not interpolated
+        std::span<std::byte> previousPositions;
+        std::span<std::byte> radii;
+        std::span<std::byte> colors;
+        std::size_t count{};
+        float interpolation{ 1.0f };
+
+        // Copies circles [begin, end) of instances, which must match count and the interpolation choice
+        void fill(const CircleInstances& instances, std::size_t begin, std::size_t end) const noexcept;
+    };
+
+    class CircleRenderer
+    {
+    public:
+        enum class Mode
+        {
+            // Triangle fan tessellation of the circle (circle.vert/circle.frag)
+            Mesh,
+            // Screen-aligned quad with analytic signed-distance coverage (circle_impostor.vert/circle_impostor.frag)
+            Impostor
+        };
+
+        static constexpr std::size_t SEGMENTS{ 100 };
+
+        CircleRenderer(ShaderProgram meshProgram, ShaderProgram impostorProgram, Mode mode = Mode::Impostor);
+
+        CircleRenderer(const CircleRenderer& other) = delete;
+        CircleRenderer(CircleRenderer&& other) noexcept = delete;
+        CircleRenderer& operator=(const CircleRenderer& other) = delete;
+        CircleRenderer& operator=(CircleRenderer&& other) noexcept = delete;
+
+        ~CircleRenderer();
+
+        // Draws every circle in a single instanced call sharing one mesh
+        void draw(const CircleInstances& instances, const Camera& camera);
+
+        // Claims buffer regions for count circles, with previous positions if interpolated; fill them, then draw
+        // with drawStaged in the same frame
+        [[nodiscard]] CircleStaging stage(std::size_t count, bool interpolated);
+
+        void drawStaged(const CircleStaging& staging, const Camera& camera);
+
+        void setMode(Mode mode) noexcept;
+
+        [[nodiscard]] Mode getMode() const noexcept;
+
+        [[nodiscard]] ShaderProgram& getProgram(Mode mode) noexcept;
+
+    private:
+        ShaderProgram m_meshProgram;
+        ShaderProgram m_impostorProgram;
+        Mode m_mode;
+
+        GLuint m_meshVertexArrayObject{};
+        GLuint m_impostorVertexArrayObject{};
+        GLuint m_meshBuffer{};
+        GLuint m_quadBuffer{};
+        GpuRingBuffer m_positionBuffer{ GL_ARRAY_BUFFER };
+        GpuRingBuffer m_previousPositionBuffer{ GL_ARRAY_BUFFER };
+        GpuRingBuffer m_radiusBuffer{ GL_ARRAY_BUFFER };
+        GpuRingBuffer m_colorBuffer{ GL_ARRAY_BUFFER };
+
+        void setupInstanceAttributes() const;
+
+        // Publishes the staged regions and points the bound vertex array at them
+        void upload(const CircleStaging& staging);
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_CIRCLERENDERER_H
@@ -0,0 +1,67 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_CONSERVATIONDIAGNOSTICS_H
+#define CONSERVATION_UTILITIES_CONSERVATIONDIAGNOSTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <glm/glm.hpp>
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+#include "utilities/SeqlockRing.h"
+
+namespace csv
+{
+    struct ConservationSample
+    {
+        std::uint64_t step{};
+        double time{};
+        double kineticEnergy{};
+        double potentialEnergy{};
+        double totalEnergy{};
+        glm::dvec2 linearMomentum{};
+        // z component of the total angular momentum about the origin
+        double angularMomentum{};
+        // Against the first sample recorded, so that readers on other threads need nothing but the sample
+        double relativeEnergyDrift{};
+    };
+
+    // Tracks the quantities the simulation is supposed to conserve, one sample per step
+    class ConservationDiagnostics
+    {
+    public:
+        static constexpr std::size_t HISTORY_SIZE{ 1024 };
+
+        // Particles per independently reduced chunk, and per job; partial sums are merged with compensated summation
+        static constexpr std::size_t CHUNK_SIZE{ 4096 };
+
+        using History = SeqlockRing<ConservationSample, HISTORY_SIZE>;
+
+        // Reduces the particle state into a sample and publishes it to the history. The potential energy is
+        // taken from the force evaluation rather than recomputed
+        const ConservationSample& record(const ParticleSystem& particles, double potentialEnergy, double time);
+
+        // Reduces chunks on worker threads; null reduces everything on the caller
+        void setJobSystem(JobSystem* jobSystem) noexcept;
+
+        // Safe to read from any thread while record() is running
+        [[nodiscard]] const History& getHistory() const noexcept;
+
+        // The first sample recorded, against which drift is measured
+        [[nodiscard]] const std::optional<ConservationSample>& getInitialSample() const noexcept;
+
+        [[nodiscard]] double getRelativeEnergyDrift(const ConservationSample& sample) const noexcept;
+
+    private:
+        History m_history{};
+        JobSystem* m_jobSystem{ nullptr };
+        std::optional<ConservationSample> m_initialSample{};
+        ConservationSample m_lastSample{};
+        std::uint64_t m_step{};
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_CONSERVATIONDIAGNOSTICS_H
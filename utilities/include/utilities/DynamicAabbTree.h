@@ -0,0 +1,135 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_DYNAMICAABBTREE_H
+#define CONSERVATION_UTILITIES_DYNAMICAABBTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "utilities/ParticleSystem.h"
+#include "utilities/broadphase.h"
+#include "utilities/geometry.h"
+
+namespace csv
+{
+    struct RayHit
+    {
+        std::uint32_t particle;
+        float distance;
+    };
+
+    // Bounding volume hierarchy over the particles, kept across steps. Leaves hold bounds fattened by a
+    // fraction of the particle radius and are only reinserted once a particle leaves its fat bounds; the
+    // ancestors of an inserted or removed leaf are refitted and rebalanced with AVL-style rotations. Handles
+    // radii spanning many orders of magnitude, where grids and sweep-and-prune degrade
+    class DynamicAabbTree
+    {
+    public:
+        static constexpr std::int32_t NULL_NODE{ -1 };
+
+        explicit DynamicAabbTree(float fatMargin = 0.25f) noexcept;
+
+        // Brings the tree up to date with the particles: adds or removes leaves to match the particle count and
+        // reinserts the leaves of particles that escaped their fat bounds
+        void update(const ParticleSystem& particles);
+
+        // Updates the tree, then replaces the contents of pairs with every pair of particles whose bounding
+        // boxes overlap
+        void findPairs(const ParticleSystem& particles, std::vector<CandidatePair>& pairs);
+
+        // Appends every particle whose bounding box overlaps region, as of the last update
+        void queryRegion(const Aabb& region, std::vector<std::uint32_t>& particles) const;
+
+        // Nearest particle hit by the ray within maxDistance, as of the last update. direction must be unit length
+        [[nodiscard]] std::optional<RayHit> raycast(const glm::vec2& origin,
+                                                    const glm::vec2& direction,
+                                                    float maxDistance) const;
+
+        [[nodiscard]] std::int32_t getHeight() const noexcept;
+
+        [[nodiscard]] std::size_t getNodeCount() const noexcept;
+
+    private:
+        struct Node
+        {
+            Aabb bounds;
+            // Next free node while the node is on the free list
+            std::int32_t parent{ NULL_NODE };
+            std::int32_t firstChild{ NULL_NODE };
+            std::int32_t secondChild{ NULL_NODE };
+            // Leaves have height 0 and free nodes -1
+            std::int32_t height{};
+            std::uint32_t particle{};
+
+            [[nodiscard]] bool isLeaf() const noexcept
+            {
+                return firstChild == NULL_NODE;
+            }
+        };
+
+        float m_fatMargin;
+        // Node pool linked by index, so growing it never invalidates links
+        std::vector<Node> m_nodes{};
+        std::int32_t m_root{ NULL_NODE };
+        std::int32_t m_freeList{ NULL_NODE };
+        std::size_t m_nodeCount{};
+        // Leaf node of each particle
+        std::vector<std::int32_t> m_leaves{};
+        // Tight bounds of each particle as of the last update
+        std::vector<Aabb> m_particleBounds{};
+        mutable std::vector<std::int32_t> m_stack{};
+        std::vector<std::pair<std::int32_t, std::int32_t>> m_pairStack{};
+
+        std::int32_t allocateNode();
+
+        void freeNode(std::int32_t node) noexcept;
+
+        void insertLeaf(std::int32_t leaf);
+
+        void removeLeaf(std::int32_t leaf) noexcept;
+
+        // Walks from node to the root, rebalancing and refitting every ancestor
+        void refitAncestors(std::int32_t node) noexcept;
+
+        // Rotates the subtree rooted at node if its children's heights differ by more than one, returning the
+        // new subtree root
+        std::int32_t balance(std::int32_t node) noexcept;
+
+        // Calls visitor with the particle of every leaf whose fat bounds overlap region
+        template<typename Visitor>
+        void query(const Aabb& region, Visitor&& visitor) const
+        {
+            if (m_root == NULL_NODE)
+            {
+                return;
+            }
+            m_stack.clear();
+            m_stack.push_back(m_root);
+            while (!m_stack.empty())
+            {
+                const auto& node{ m_nodes[m_stack.back()] };
+                m_stack.pop_back();
+                if (!node.bounds.overlaps(region))
+                {
+                    continue;
+                }
+                if (node.isLeaf())
+                {
+                    visitor(node.particle);
+                }
+                else
+                {
+                    m_stack.push_back(node.firstChild);
+                    m_stack.push_back(node.secondChild);
+                }
+            }
+        }
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_DYNAMICAABBTREE_H
@@ -0,0 +1,125 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_FASTMULTIPOLE_H
+#define CONSERVATION_UTILITIES_FASTMULTIPOLE_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+
+namespace csv
+{
+    // Two-dimensional fast multipole method on a uniform quadtree, using the complex-variable multipole and local
+    // expansions of Greengard and Rokhlin. The kernel is the planar one, a potential of log r and a force of 1 / r,
+    // for either gravity between masses or electrostatics between charges. Runs in O(n) for a fixed order.
+    // Satisfies ForceLaw
+    class FastMultipole
+    {
+    public:
+        enum class Interaction
+        {
+            // Masses attract; the source strength is the mass
+            Gravity,
+            // Like charges repel; the source strength is the charge and the response is divided by the mass
+            Coulomb
+        };
+
+        struct Settings
+        {
+            Interaction interaction{ Interaction::Gravity };
+            // Number of expansion terms; the error falls roughly as 0.55^order
+            std::size_t order{ 12 };
+            // Target average number of particles per leaf box
+            std::size_t leafSize{ 32 };
+            // G for gravity, k for electrostatics
+            float couplingConstant{ 1.0f };
+            // Plummer softening, applied only between particles in adjacent leaves; far boxes are unsoftened
+            float softening{ 0.01f };
+        };
+
+        struct Error
+        {
+            // Both relative to the root mean square of the exact accelerations
+            double rms;
+            double max;
+        };
+
+        FastMultipole();
+
+        explicit FastMultipole(const Settings& settings);
+
+        double operator()(const ParticleSystem& particles, std::span<glm::vec2> accelerations);
+
+        // Smallest order whose worst-case truncation error bound is below tolerance
+        [[nodiscard]] static std::size_t orderForTolerance(double tolerance) noexcept;
+
+        // Compares accelerations against direct summation over every particle, at sampleCount evenly spaced
+        // particles. O(sampleCount * n)
+        [[nodiscard]] Error measureError(const ParticleSystem& particles,
+                                         std::span<const glm::vec2> accelerations,
+                                         std::size_t sampleCount) const;
+
+        [[nodiscard]] const Settings& getSettings() const noexcept;
+
+        // Spreads each pass over the boxes of a level across worker threads; null runs everything on the caller
+        void setJobSystem(JobSystem* jobSystem) noexcept;
+
+        [[nodiscard]] std::size_t getLevelCount() const noexcept;
+
+    private:
+        using Complex = std::complex<double>;
+
+        Settings m_settings;
+        JobSystem* m_jobSystem{ nullptr };
+        // Binomial coefficients up to 2 * order
+        std::vector<std::vector<double>> m_binomials{};
+
+        std::size_t m_levelCount{};
+        glm::dvec2 m_origin{};
+        double m_rootSize{};
+
+        // Counting-sorted particles of the finest level, row-major by box
+        std::vector<std::uint32_t> m_boxStarts{};
+        std::vector<std::uint32_t> m_particleBoxes{};
+        std::vector<std::uint32_t> m_sortedIndices{};
+        std::vector<Complex> m_sortedPositions{};
+        std::vector<double> m_sortedStrengths{};
+
+        // Per level, row-major by box: particle counts, and order + 1 coefficients per box
+        std::vector<std::vector<std::uint32_t>> m_counts{};
+        std::vector<std::vector<Complex>> m_multipoles{};
+        std::vector<std::vector<Complex>> m_locals{};
+
+        void bin(const ParticleSystem& particles);
+
+        void formMultipoles();
+
+        void translateMultipolesUp();
+
+        void convertMultipolesToLocals();
+
+        void translateLocalsDown();
+
+        // Evaluates the local expansion and the near field at every particle; returns the sum of strength times
+        // potential
+        double evaluate(const ParticleSystem& particles, std::span<glm::vec2> accelerations) const;
+
+        [[nodiscard]] Complex getBoxCenter(std::size_t level, std::uint32_t column, std::uint32_t row) const noexcept;
+
+        [[nodiscard]] double getStrength(const ParticleSystem& particles, std::size_t index) const noexcept;
+
+        // Maps a field conj(dPhi/dz) at a particle to its acceleration
+        [[nodiscard]] glm::vec2 toAcceleration(const ParticleSystem& particles,
+                                               std::size_t index,
+                                               const glm::dvec2& field) const noexcept;
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_FASTMULTIPOLE_H
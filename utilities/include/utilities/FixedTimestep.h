@@ -0,0 +1,39 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_FIXEDTIMESTEP_H
+#define CONSERVATION_UTILITIES_FIXEDTIMESTEP_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace csv
+{
+    // Converts variable frame times into a whole number of fixed simulation steps
+    class FixedTimestep
+    {
+    public:
+        explicit FixedTimestep(double stepSeconds, std::size_t maxStepsPerFrame = 8) noexcept;
+
+        // Accumulates frameSeconds and returns how many steps to run this frame. Time that would need more than
+        // maxStepsPerFrame steps is dropped, so a slow frame cannot cause ever longer catch-up frames
+        [[nodiscard]] std::size_t advance(double frameSeconds) noexcept;
+
+        // Fraction of a step left in the accumulator, used to blend the previous and current states for rendering
+        [[nodiscard]] float getInterpolation() const noexcept;
+
+        [[nodiscard]] double getStepSeconds() const noexcept;
+
+        // Total number of steps dropped by the catch-up cap
+        [[nodiscard]] std::uint64_t getDroppedSteps() const noexcept;
+
+    private:
+        double m_stepSeconds;
+        std::size_t m_maxStepsPerFrame;
+        double m_accumulator{};
+        std::uint64_t m_droppedSteps{};
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_FIXEDTIMESTEP_H
@@ -0,0 +1,54 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_GLSTATE_H
+#define CONSERVATION_UTILITIES_GLSTATE_H
+
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace csv
+{
+    // Shadows the bindings of the current context and drops calls that would not change them.
+    // All program, vertex array, buffer and blend state changes in utilities go through here.
+    class GlState
+    {
+    public:
+        struct Counters
+        {
+            std::uint64_t issued{};
+            std::uint64_t skipped{};
+        };
+
+        static void useProgram(GLuint program);
+
+        static void bindVertexArray(GLuint vertexArray);
+
+        static void bindBuffer(GLenum target, GLuint buffer);
+
+        // Indexed bindings are always issued; the generic binding point they also set is tracked
+        static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+        static void setBlending(bool enabled);
+
+        static void setBlendFunction(GLenum sourceFactor, GLenum destinationFactor);
+
+        // Deleting a bound object unbinds it, and its name may be recycled
+        static void onProgramDeleted(GLuint program);
+
+        static void onVertexArrayDeleted(GLuint vertexArray);
+
+        static void onBufferDeleted(GLuint buffer);
+
+        // Forgets everything, e.g. after code outside utilities changed the state directly
+        static void invalidate();
+
+        // Starts a new frame and returns the counters of the previous one
+        static Counters beginFrame();
+
+        [[nodiscard]] static const Counters& getFrameCounters();
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_GLSTATE_H
@@ -0,0 +1,88 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_GPURINGBUFFER_H
+#define CONSERVATION_UTILITIES_GPURINGBUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
+#include <glad/glad.h>
+
+namespace csv
+{
+    // Streams per-frame data through a buffer split into regions that the CPU and GPU take turns on.
+    // Uses a persistent coherent mapping when GL_ARB_buffer_storage is available and falls back to
+    // orphaning plus glBufferSubData on plain GL 3.3.
+    class GpuRingBuffer
+    {
+    public:
+        static constexpr std::size_t DEFAULT_REGION_COUNT{ 3 };
+        static constexpr std::size_t REGION_ALIGNMENT{ 256 };
+
+        explicit GpuRingBuffer(GLenum target,
+                               std::size_t regionSize = REGION_ALIGNMENT,
+                               std::size_t regionCount = DEFAULT_REGION_COUNT);
+
+        GpuRingBuffer(const GpuRingBuffer& other) = delete;
+        GpuRingBuffer(GpuRingBuffer&& other) noexcept = delete;
+        GpuRingBuffer& operator=(const GpuRingBuffer& other) = delete;
+        GpuRingBuffer& operator=(GpuRingBuffer&& other) noexcept = delete;
+
+        ~GpuRingBuffer();
+
+        // Grows every region to at least regionSize bytes; waits for the GPU if the storage is replaced
+        void reserve(std::size_t regionSize);
+
+        // Waits until the GPU has released the current region and returns it for writing
+        [[nodiscard]] std::span<std::byte> beginWrite();
+
+        // Publishes the first writtenBytes of the current region and returns its offset within the buffer
+        GLintptr endWrite(std::size_t writtenBytes);
+
+        // Guards the current region with a fence and advances to the next; call after the last command reading it
+        void fence();
+
+        template<typename T>
+        GLintptr write(std::span<const T> data);
+
+        [[nodiscard]] GLuint getId() const noexcept;
+
+        [[nodiscard]] std::size_t getRegionSize() const noexcept;
+
+        [[nodiscard]] bool isPersistent() const noexcept;
+
+    private:
+        GLenum m_target;
+        GLuint m_bufferId{};
+        std::size_t m_regionSize;
+        std::size_t m_regionCount;
+        std::size_t m_regionIndex{};
+        bool m_persistent;
+
+        std::byte* m_mapping{};
+        std::vector<std::byte> m_staging{};
+        std::vector<GLsync> m_fences;
+
+        void allocate();
+
+        void release();
+
+        void waitForRegion(std::size_t regionIndex);
+
+        [[nodiscard]] GLintptr getRegionOffset() const noexcept;
+    };
+
+    template<typename T>
+    GLintptr GpuRingBuffer::write(const std::span<const T> data)
+    {
+        reserve(data.size_bytes());
+        const auto region{ beginWrite() };
+        std::memcpy(region.data(), data.data(), data.size_bytes());
+        return endWrite(data.size_bytes());
+    }
+} // csv
+
+#endif //CONSERVATION_UTILITIES_GPURINGBUFFER_H
@@ -0,0 +1,95 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_GPUTIMER_H
+#define CONSERVATION_UTILITIES_GPUTIMER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <glad/glad.h>
+
+namespace csv
+{
+    // Measures named passes on the GPU with GL_TIMESTAMP queries and on the CPU with a steady clock.
+    // Queries are recycled through a ring of frames and read back LATENCY frames later, so reading never stalls;
+    // a frame whose queries are still not available is dropped instead.
+    class GpuTimer
+    {
+    public:
+        static constexpr std::size_t LATENCY{ 4 };
+
+        struct PassTiming
+        {
+            std::string_view name;
+            double gpuMilliseconds;
+            double cpuMilliseconds;
+        };
+
+        // Times everything issued between construction and destruction; name must outlive the timer
+        class Scope
+        {
+        public:
+            Scope(GpuTimer& timer, std::string_view name);
+
+            Scope(const Scope& other) = delete;
+            Scope(Scope&& other) noexcept = delete;
+            Scope& operator=(const Scope& other) = delete;
+            Scope& operator=(Scope&& other) noexcept = delete;
+
+            ~Scope();
+
+        private:
+            GpuTimer& m_timer;
+            std::size_t m_index;
+        };
+
+        explicit GpuTimer(std::size_t maxScopesPerFrame = 32);
+
+        GpuTimer(const GpuTimer& other) = delete;
+        GpuTimer(GpuTimer&& other) noexcept = delete;
+        GpuTimer& operator=(const GpuTimer& other) = delete;
+        GpuTimer& operator=(GpuTimer&& other) noexcept = delete;
+
+        ~GpuTimer();
+
+        // Collects the oldest frame in the ring if the GPU has finished it, then starts recording a new one
+        void beginFrame();
+
+        // Passes of the most recently collected frame, in the order they began
+        [[nodiscard]] std::span<const PassTiming> getResults() const noexcept;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct ScopeRecord
+        {
+            std::string_view name;
+            Clock::time_point cpuBegin;
+            Clock::time_point cpuEnd;
+        };
+
+        struct Frame
+        {
+            std::vector<GLuint> queries;
+            std::vector<ScopeRecord> scopes;
+        };
+
+        std::size_t m_maxScopesPerFrame;
+        std::array<Frame, LATENCY> m_frames{};
+        std::size_t m_frameIndex{};
+        std::vector<PassTiming> m_results{};
+
+        std::size_t beginScope(std::string_view name);
+
+        void endScope(std::size_t index);
+
+        void collect(Frame& frame);
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_GPUTIMER_H
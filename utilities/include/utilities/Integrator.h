@@ -0,0 +1,217 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_INTEGRATOR_H
+#define CONSERVATION_UTILITIES_INTEGRATOR_H
+
+#include <cmath>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <glm/glm.hpp>
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+#include "utilities/forces.h"
+
+namespace csv
+{
+    // Sub-steps available to an integration scheme. Each one is a single sweep over the particle columns, split
+    // into chunks across the job system's workers when there is one
+    template<ForceLaw Force>
+    class IntegratorStages
+    {
+    public:
+        IntegratorStages(ParticleSystem& particles, Force& force, JobSystem* jobSystem = nullptr) noexcept
+            : m_particles{ particles }
+            , m_force{ force }
+            , m_jobSystem{ jobSystem }
+        {
+        }
+
+        void kick(const float deltaTime)
+        {
+            const auto velocities{ m_particles.getVelocities() };
+            const auto accelerations{ m_particles.getAccelerations() };
+            sweep([&](const std::size_t index)
+            {
+                velocities[index] += accelerations[index] * deltaTime;
+            });
+        }
+
+        void drift(const float deltaTime)
+        {
+            const auto positions{ m_particles.getPositions() };
+            const auto velocities{ m_particles.getVelocities() };
+            sweep([&](const std::size_t index)
+            {
+                positions[index] += velocities[index] * deltaTime;
+            });
+        }
+
+        // kick(kickTime) followed by drift(driftTime) in one sweep
+        void kickDrift(const float kickTime, const float driftTime)
+        {
+            const auto positions{ m_particles.getPositions() };
+            const auto velocities{ m_particles.getVelocities() };
+            const auto accelerations{ m_particles.getAccelerations() };
+            sweep([&](const std::size_t index)
+            {
+                velocities[index] += accelerations[index] * kickTime;
+                positions[index] += velocities[index] * driftTime;
+            });
+        }
+
+        void computeForces()
+        {
+            m_potentialEnergy = m_force(std::as_const(m_particles), m_particles.getAccelerations());
+        }
+
+        [[nodiscard]] double getPotentialEnergy() const noexcept
+        {
+            return m_potentialEnergy;
+        }
+
+    private:
+        // Particles per job; the sweeps do a few flops per particle, so chunks must be large to pay for a job
+        static constexpr std::size_t SWEEP_GRAIN{ 16384 };
+
+        ParticleSystem& m_particles;
+        Force& m_force;
+        JobSystem* m_jobSystem;
+        double m_potentialEnergy{};
+
+        // Calls body(index) for every particle; each index is touched by one thread only, so the result is the same
+        // with or without workers
+        template<typename Body>
+        void sweep(const Body& body)
+        {
+            const auto sweepChunk{ [&](const std::size_t begin, const std::size_t end)
+            {
+                for (const auto index : std::views::iota(begin, end))
+                {
+                    body(index);
+                }
+            } };
+            parallelFor(m_jobSystem, 0, m_particles.size(), SWEEP_GRAIN, sweepChunk);
+        }
+    };
+
+    // Second order, one force evaluation per step; the half kick and the drift share a sweep
+    struct VelocityVerlet
+    {
+        static constexpr std::string_view NAME{ "velocity Verlet" };
+
+        template<typename Stages>
+        static void step(Stages& stages, const float deltaTime)
+        {
+            stages.kickDrift(0.5f * deltaTime, deltaTime);
+            stages.computeForces();
+            stages.kick(0.5f * deltaTime);
+        }
+    };
+
+    // Second order kick-drift-kick leapfrog. Algebraically the same map as velocity Verlet, but each sub-step
+    // is its own sweep, which is the form the higher order compositions are built from
+    struct Leapfrog
+    {
+        static constexpr std::string_view NAME{ "leapfrog (KDK)" };
+
+        template<typename Stages>
+        static void step(Stages& stages, const float deltaTime)
+        {
+            stages.kick(0.5f * deltaTime);
+            stages.drift(deltaTime);
+            stages.computeForces();
+            stages.kick(0.5f * deltaTime);
+        }
+    };
+
+    // Fourth order Forest-Ruth (Yoshida triple jump of the leapfrog), three force evaluations per step
+    struct ForestRuth
+    {
+        static constexpr std::string_view NAME{ "Forest-Ruth" };
+
+        template<typename Stages>
+        static void step(Stages& stages, const float deltaTime)
+        {
+            const auto theta{ static_cast<float>(1.0 / (2.0 - std::cbrt(2.0))) };
+            stages.kickDrift(0.5f * theta * deltaTime, theta * deltaTime);
+            stages.computeForces();
+            stages.kickDrift(0.5f * (1.0f - theta) * deltaTime, (1.0f - 2.0f * theta) * deltaTime);
+            stages.computeForces();
+            stages.kickDrift(0.5f * (1.0f - theta) * deltaTime, theta * deltaTime);
+            stages.computeForces();
+            stages.kick(0.5f * theta * deltaTime);
+        }
+    };
+
+    template<typename T>
+    concept IntegrationScheme = requires(IntegratorStages<HarmonicWell>& stages, float deltaTime)
+    {
+        { T::NAME } -> std::convertible_to<std::string_view>;
+        T::step(stages, deltaTime);
+    };
+
+    // Advances a particle system under a force law with a given scheme. Both are template parameters so the
+    // force evaluation is inlined into the scheme's sweeps without any dynamic dispatch
+    template<IntegrationScheme Scheme, ForceLaw Force>
+    class Integrator
+    {
+    public:
+        explicit Integrator(Force force = {}) noexcept
+            : m_force{ std::move(force) }
+        {
+        }
+
+        void step(ParticleSystem& particles, const float deltaTime)
+        {
+            IntegratorStages<Force> stages{ particles, m_force, m_jobSystem };
+            // The schemes start with a kick that reuses the previous step's accelerations, which are stale
+            // whenever particles were added or removed since then
+            if (particles.size() != m_primedSize)
+            {
+                stages.computeForces();
+                m_primedSize = particles.size();
+            }
+            Scheme::step(stages, deltaTime);
+            m_potentialEnergy = stages.getPotentialEnergy();
+        }
+
+        // Potential energy at the positions reached by the last step
+        [[nodiscard]] double getPotentialEnergy() const noexcept
+        {
+            return m_potentialEnergy;
+        }
+
+        [[nodiscard]] Force& getForce() noexcept
+        {
+            return m_force;
+        }
+
+        // Spreads the kick and drift sweeps across worker threads; null runs them on the caller. The force law has
+        // its own job system setting
+        void setJobSystem(JobSystem* jobSystem) noexcept
+        {
+            m_jobSystem = jobSystem;
+        }
+
+        // Forces accelerations to be recomputed before the next step, e.g. after editing particles in place
+        void invalidate() noexcept
+        {
+            m_primedSize = INVALID_SIZE;
+        }
+
+    private:
+        static constexpr std::size_t INVALID_SIZE{ static_cast<std::size_t>(-1) };
+
+        Force m_force;
+        JobSystem* m_jobSystem{ nullptr };
+        double m_potentialEnergy{};
+        std::size_t m_primedSize{ INVALID_SIZE };
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_INTEGRATOR_H
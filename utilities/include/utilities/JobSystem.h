@@ -0,0 +1,183 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_JOBSYSTEM_H
+#define CONSERVATION_UTILITIES_JOBSYSTEM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+#include "utilities/WorkStealingDeque.h"
+
+namespace csv
+{
+    // Fixed pool of worker threads, each with its own work-stealing deque. A thread that submits work runs its own
+    // jobs too while it waits, so nested submissions from inside a job cannot deadlock, and several threads can
+    // share one pool without picking up each other's work. Jobs must not throw
+    class JobSystem
+    {
+    public:
+        // Jobs one thread can have queued at once; a submitter that fills its deque runs its own jobs to make room
+        static constexpr std::size_t QUEUE_CAPACITY{ 4096 };
+
+        // Threads besides the workers that may submit concurrently, such as the main and simulation threads.
+        // Further threads still work but run their jobs serially
+        static constexpr std::size_t MAX_EXTERNAL_THREADS{ 8 };
+
+        // One call of function(context, index); pending, if not null, is decremented once the call has returned
+        struct Job
+        {
+            void (*function)(const void*, std::size_t);
+            const void* context;
+            std::size_t index;
+            std::atomic<std::size_t>* pending;
+        };
+
+        explicit JobSystem(std::size_t workerCount = getDefaultWorkerCount());
+
+        JobSystem(const JobSystem& other) = delete;
+        JobSystem(JobSystem&& other) noexcept = delete;
+        JobSystem& operator=(const JobSystem& other) = delete;
+        JobSystem& operator=(JobSystem&& other) noexcept = delete;
+
+        ~JobSystem();
+
+        // Calls function(context, index) for every index in [0, count) and returns once all calls have finished.
+        // While waiting the caller runs only jobs of this call that no worker has taken yet
+        void run(std::size_t count, void (*function)(const void*, std::size_t), const void* context);
+
+        template<typename Function>
+        void run(const std::size_t count, const Function& function)
+        {
+            run(count,
+                [](const void* context, const std::size_t index) { (*static_cast<const Function*>(context))(index); },
+                &function);
+        }
+
+        // Queues job for any thread and returns at once; the job must stay alive until it has run. Fails, leaving the
+        // job to the caller, if there are no workers or the calling thread's queue is unavailable or full
+        [[nodiscard]] bool trySubmit(Job& job);
+
+        // Runs one job the calling thread queued and no worker has taken yet, so that a thread waiting on work it
+        // submitted helps with it
+        bool runQueuedJob();
+
+        [[nodiscard]] std::size_t getWorkerCount() const noexcept;
+
+        // One worker per hardware thread, less the submitting thread which works while it waits
+        [[nodiscard]] static std::size_t getDefaultWorkerCount() noexcept;
+
+    private:
+        using Queue = WorkStealingDeque<Job, QUEUE_CAPACITY>;
+
+        // Distinguishes this system from any earlier one at the same address in threads' cached queue indices
+        std::uint64_t m_id;
+        std::size_t m_workerCount;
+        // Workers' queues first, then one per external thread slot
+        std::vector<std::unique_ptr<Queue>> m_queues{};
+        // Claimed flags of the external queues; shared with the threads holding one, which release it on exit
+        using ExternalSlots = std::array<std::atomic<bool>, MAX_EXTERNAL_THREADS>;
+        std::shared_ptr<ExternalSlots> m_externalSlots;
+        // Bumped whenever work is published, so that idle workers can sleep on it
+        std::atomic<std::uint32_t> m_epoch{};
+        std::atomic<bool> m_running{ true };
+        std::vector<std::jthread> m_workers{};
+
+        void workerLoop(std::size_t queueIndex);
+
+        // Queue owned by the calling thread, claiming an external slot on first use
+        [[nodiscard]] std::optional<std::size_t> getQueueIndex();
+
+        [[nodiscard]] Job* findJob(std::size_t queueIndex, std::size_t& nextVictim) const noexcept;
+
+        // Top of the calling thread's own queue, if there is one and, unless batch is null, it is one of that batch's
+        [[nodiscard]] Job* popOwnJob(std::size_t queueIndex, const std::atomic<std::size_t>* batch) noexcept;
+
+        void wake() noexcept;
+
+        static void execute(const Job& job) noexcept;
+    };
+
+    // Calls body(chunkBegin, chunkEnd) over [begin, end) cut into chunks of grainSize. A null job system runs the
+    // whole range on the calling thread
+    template<typename Body>
+    void parallelFor(JobSystem* jobSystem,
+                     const std::size_t begin,
+                     const std::size_t end,
+                     const std::size_t grainSize,
+                     const Body& body)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        const auto grain{ std::max(grainSize, 1uz) };
+        const auto chunkCount{ (end - begin + grain - 1) / grain };
+        if (jobSystem == nullptr || chunkCount == 1)
+        {
+            body(begin, end);
+            return;
+        }
+
+        jobSystem->run(chunkCount, [&](const std::size_t chunk)
+        {
+            const auto chunkBegin{ begin + chunk * grain };
+            body(chunkBegin, std::min(chunkBegin + grain, end));
+        });
+    }
+
+    // Maps every chunk of [begin, end) to a partial result with map(chunkBegin, chunkEnd), then folds the partials
+    // with combine in chunk order, so the result does not depend on the number of threads
+    template<typename T, typename Map, typename Combine>
+    [[nodiscard]] T parallelReduce(JobSystem* jobSystem,
+                                   const std::size_t begin,
+                                   const std::size_t end,
+                                   const std::size_t grainSize,
+                                   const T& identity,
+                                   const Map& map,
+                                   const Combine& combine)
+    {
+        if (begin >= end)
+        {
+            return identity;
+        }
+
+        // Chunked the same way with or without a job system, so that the summation order never changes
+        const auto grain{ std::max(grainSize, 1uz) };
+        std::vector<T> partials((end - begin + grain - 1) / grain, identity);
+        const auto mapChunk{ [&](const std::size_t chunk)
+        {
+            const auto chunkBegin{ begin + chunk * grain };
+            partials[chunk] = map(chunkBegin, std::min(chunkBegin + grain, end));
+        } };
+        if (jobSystem == nullptr)
+        {
+            for (const auto chunk : std::views::iota(0uz, partials.size()))
+            {
+                mapChunk(chunk);
+            }
+        }
+        else
+        {
+            jobSystem->run(partials.size(), mapChunk);
+        }
+
+        auto result{ identity };
+        for (const auto& partial : partials)
+        {
+            result = combine(result, partial);
+        }
+        return result;
+    }
+} // csv
+
+#endif //CONSERVATION_UTILITIES_JOBSYSTEM_H
@@ -0,0 +1,116 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_PARTICLESYSTEM_H
+#define CONSERVATION_UTILITIES_PARTICLESYSTEM_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include "utilities/AlignedAllocator.h"
+
+namespace csv
+{
+    template<typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    struct Particle
+    {
+        glm::vec2 position{};
+        glm::vec2 velocity{};
+        float mass{ 1.0f };
+        float radius{ 1.0f };
+        float charge{ 0.0f };
+        glm::vec4 color{ 1.0f };
+    };
+
+    // Particle state stored as structure-of-arrays columns, each tightly packed and cache-line aligned so that
+    // a column can be handed to the GPU or a vectorized loop as one contiguous span
+    class ParticleSystem
+    {
+    public:
+        ParticleSystem() = default;
+
+        explicit ParticleSystem(std::size_t capacity);
+
+        // Grows every column to hold at least capacity particles; add() only reallocates past this point
+        void reserve(std::size_t capacity);
+
+        std::size_t add(const Particle& particle);
+
+        // Removes a particle by moving the last particle into its slot
+        void remove(std::size_t index) noexcept;
+
+        void clear() noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] std::size_t capacity() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] Particle get(std::size_t index) const noexcept;
+
+        [[nodiscard]] std::span<glm::vec2> getPositions() noexcept;
+
+        [[nodiscard]] std::span<const glm::vec2> getPositions() const noexcept;
+
+        // Positions as of the last storePreviousPositions(), for interpolating between simulation steps
+        [[nodiscard]] std::span<const glm::vec2> getPreviousPositions() const noexcept;
+
+        void storePreviousPositions() noexcept;
+
+        [[nodiscard]] std::span<glm::vec2> getVelocities() noexcept;
+
+        [[nodiscard]] std::span<const glm::vec2> getVelocities() const noexcept;
+
+        // Accelerations from the most recent force evaluation, kept between steps by the integrators
+        [[nodiscard]] std::span<glm::vec2> getAccelerations() noexcept;
+
+        [[nodiscard]] std::span<const glm::vec2> getAccelerations() const noexcept;
+
+        [[nodiscard]] std::span<float> getMasses() noexcept;
+
+        [[nodiscard]] std::span<const float> getMasses() const noexcept;
+
+        [[nodiscard]] std::span<float> getRadii() noexcept;
+
+        [[nodiscard]] std::span<const float> getRadii() const noexcept;
+
+        [[nodiscard]] std::span<float> getCharges() noexcept;
+
+        [[nodiscard]] std::span<const float> getCharges() const noexcept;
+
+        [[nodiscard]] std::span<glm::vec4> getColors() noexcept;
+
+        [[nodiscard]] std::span<const glm::vec4> getColors() const noexcept;
+
+    private:
+        AlignedVector<glm::vec2> m_positions{};
+        AlignedVector<glm::vec2> m_previousPositions{};
+        AlignedVector<glm::vec2> m_velocities{};
+        AlignedVector<glm::vec2> m_accelerations{};
+        AlignedVector<float> m_masses{};
+        AlignedVector<float> m_radii{};
+        AlignedVector<float> m_charges{};
+        AlignedVector<glm::vec4> m_colors{};
+
+        // Applies function to every column so that they are always resized together
+        template<typename Function>
+        void forEachColumn(Function&& function)
+        {
+            function(m_positions);
+            function(m_previousPositions);
+            function(m_velocities);
+            function(m_accelerations);
+            function(m_masses);
+            function(m_radii);
+            function(m_charges);
+            function(m_colors);
+        }
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_PARTICLESYSTEM_H
@@ -0,0 +1,53 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_PROGRAMBINARYCACHE_H
+#define CONSERVATION_UTILITIES_PROGRAMBINARYCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <glad/glad.h>
+
+namespace csv
+{
+    // Stores linked program binaries on disk, keyed by the shader sources and the driver that built them
+    class ProgramBinaryCache
+    {
+    public:
+        explicit ProgramBinaryCache(std::filesystem::path directory);
+
+        // $XDG_CACHE_HOME/conservation/programs, falling back to ~/.cache and then the temporary directory
+        [[nodiscard]] static ProgramBinaryCache& getDefault();
+
+        // Requires GL_ARB_get_program_binary and at least one binary format; checked on first use
+        [[nodiscard]] bool isSupported() const;
+
+        // Must be called before linking for the driver to keep the binary retrievable
+        void prepareForCaching(GLuint program) const;
+
+        [[nodiscard]] std::uint64_t makeKey(std::span<const std::string_view> sources) const;
+
+        // Hands the cached binary to the driver without waiting for it; false when there is no usable entry.
+        // The driver may still reject the binary, which shows up in the program's link status.
+        [[nodiscard]] bool restore(GLuint program, std::uint64_t key) const;
+
+        // Removes an entry whose binary the driver rejected
+        void evict(std::uint64_t key) const;
+
+        void store(GLuint program, std::uint64_t key) const;
+
+        [[nodiscard]] const std::filesystem::path& getDirectory() const noexcept;
+
+    private:
+        std::filesystem::path m_directory;
+        mutable std::optional<bool> m_supported{};
+
+        [[nodiscard]] std::filesystem::path getEntryPath(std::uint64_t key) const;
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_PROGRAMBINARYCACHE_H
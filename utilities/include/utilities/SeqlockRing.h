@@ -0,0 +1,131 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SEQLOCKRING_H
+#define CONSERVATION_UTILITIES_SEQLOCKRING_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include "utilities/AlignedAllocator.h"
+
+namespace csv
+{
+    // Fixed-size history written by one thread and read by any number of threads without locks. Each slot is
+    // guarded by a sequence number; readers retry or skip a slot the writer is overwriting instead of blocking it
+    template<typename T, std::size_t Capacity>
+        requires std::is_trivially_copyable_v<T> && (Capacity > 1)
+    class SeqlockRing
+    {
+    public:
+        // Must only be called from the writing thread
+        void push(const T& value) noexcept
+        {
+            const auto index{ m_writeCount.load(std::memory_order_relaxed) };
+            auto& slot{ m_slots[index % Capacity] };
+
+            slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::array<std::uint64_t, WORDS> words{};
+            std::memcpy(words.data(), &value, sizeof(T));
+            for (const auto word : std::views::iota(0uz, WORDS))
+            {
+                slot.words[word].store(words[word], std::memory_order_relaxed);
+            }
+
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+            m_writeCount.store(index + 1, std::memory_order_release);
+        }
+
+        [[nodiscard]] std::optional<T> latest() const noexcept
+        {
+            T value;
+            while (true)
+            {
+                const auto count{ m_writeCount.load(std::memory_order_acquire) };
+                if (count == 0)
+                {
+                    return std::nullopt;
+                }
+                if (tryRead(count - 1, value))
+                {
+                    return value;
+                }
+            }
+        }
+
+        // Copies up to destination.size() of the most recent values, oldest first, and returns how many were
+        // copied. Values overwritten while being read are left out
+        std::size_t readRecent(const std::span<T> destination) const noexcept
+        {
+            const auto count{ m_writeCount.load(std::memory_order_acquire) };
+            // Leave out the oldest slot, which the writer may already be reusing
+            const auto available{ std::min({ static_cast<std::uint64_t>(destination.size()), count, static_cast<std::uint64_t>(Capacity - 1) }) };
+
+            auto copied{ 0uz };
+            for (const auto index : std::views::iota(count - available, count))
+            {
+                if (tryRead(index, destination[copied]))
+                {
+                    ++copied;
+                }
+            }
+            return copied;
+        }
+
+        // Number of values pushed since construction
+        [[nodiscard]] std::uint64_t getWriteCount() const noexcept
+        {
+            return m_writeCount.load(std::memory_order_acquire);
+        }
+
+    private:
+        static constexpr std::size_t WORDS{ (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) };
+
+        // The payload is stored as relaxed atomic words so that a read racing a write is well defined
+        struct alignas(CACHE_LINE_SIZE) Slot
+        {
+            // Odd while value 2 * index + 1 is being written, 2 * index + 2 once it is complete
+            std::atomic<std::uint64_t> sequence{};
+            std::array<std::atomic<std::uint64_t>, WORDS> words{};
+        };
+
+        bool tryRead(const std::uint64_t index, T& value) const noexcept
+        {
+            const auto& slot{ m_slots[index % Capacity] };
+            const auto before{ slot.sequence.load(std::memory_order_acquire) };
+            if (before != 2 * index + 2)
+            {
+                return false;
+            }
+
+            std::array<std::uint64_t, WORDS> words{};
+            for (const auto word : std::views::iota(0uz, WORDS))
+            {
+                words[word] = slot.words[word].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != before)
+            {
+                return false;
+            }
+            std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+            return true;
+        }
+
+        std::array<Slot, Capacity> m_slots{};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_writeCount{};
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SEQLOCKRING_H
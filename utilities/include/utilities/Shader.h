@@ -24,6 +24,14 @@ namespace csv
 
         static Shader loadFromFile(const std::filesystem::path& shaderPath, Type shaderType);
 
+        static Shader fromSource(std::string_view source, Type shaderType);
+
+        // Issues the compilation without waiting for it; validate() before relying on the result
+        static Shader submitSource(std::string_view source, Type shaderType);
+
+        // Checks that the file exists and deduces its type from the .vert/.frag extension
+        static Type deduceType(const std::filesystem::path& shaderPath);
+
         Shader(const Shader& other) = delete;
         Shader(Shader&& other) noexcept;
         Shader& operator=(const Shader& other) = delete;
@@ -33,6 +41,9 @@ namespace csv
 
         [[nodiscard]] GLuint getId() const;
 
+        // Blocks until compilation finishes and throws if it failed
+        void validate() const;
+
     private:
         GLuint m_shaderId;
 
@@ -42,8 +53,6 @@ namespace csv
 
         void compile(std::string_view source) const;
 
-        void validate() const;
-
         static Shader loadFromFile(const std::filesystem::path& shaderPath,
                                    Type shaderType,
                                    bool bypassValidation);
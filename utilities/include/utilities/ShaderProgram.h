@@ -5,22 +5,74 @@
 #ifndef CONSERVATION_UTILITIES_SHADERPROGRAM_H
 #define CONSERVATION_UTILITIES_SHADERPROGRAM_H
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include "utilities/Shader.h"
+#include "utilities/hash.h"
 
 namespace csv
 {
     class Shader;
 
+    // Uniform name with its hash; string literals are hashed at compile time
+    class UniformName
+    {
+    public:
+        template<std::size_t N>
+        // ReSharper disable once CppNonExplicitConvertingConstructor
+        consteval UniformName(const char (&name)[N]) noexcept
+            : m_name{ name, N - 1 }
+            , m_hash{ fnv1a(m_name) }
+        {
+        }
+
+        explicit constexpr UniformName(const std::string_view name) noexcept
+            : m_name{ name }
+            , m_hash{ fnv1a(name) }
+        {
+        }
+
+        [[nodiscard]] constexpr std::string_view getName() const noexcept
+        {
+            return m_name;
+        }
+
+        [[nodiscard]] constexpr std::uint64_t getHash() const noexcept
+        {
+            return m_hash;
+        }
+
+    private:
+        std::string_view m_name;
+        std::uint64_t m_hash;
+    };
+
+    struct ShaderProgramFiles
+    {
+        std::filesystem::path vertexShaderFile;
+        std::filesystem::path fragmentShaderFile;
+    };
+
+    class PendingShaderProgram;
+
     class ShaderProgram
     {
     public:
         [[nodiscard]] static ShaderProgram load(const std::filesystem::path& vertexShaderFile,
                                                 const std::filesystem::path& fragmentShaderFile);
 
+        // Submits every compilation and linkage before querying any status, so the driver can work on them
+        // concurrently (in parallel with GL_KHR_parallel_shader_compile)
+        [[nodiscard]] static std::vector<PendingShaderProgram> loadBatch(std::span<const ShaderProgramFiles> programs);
+
         explicit ShaderProgram(GLuint program);
         ShaderProgram();
 
@@ -33,15 +85,26 @@ namespace csv
 
         [[nodiscard]] GLuint getId() const;
 
-        [[nodiscard]] GLint getUniformLocation(std::string_view name) const;
+        // Looks the location up in the table built at link time, never in the driver
+        [[nodiscard]] GLint getUniformLocation(UniformName name) const;
 
         template<typename... Args>
-        void setUniform(std::string_view name, Args... args) const;
+        void setUniform(UniformName name, Args... args) const;
 
         void use() const;
 
     private:
+        friend class PendingShaderProgram;
+
+        struct UniformSlot
+        {
+            std::uint64_t hash{};
+            GLint location{ -1 };
+        };
+
         GLuint m_programId;
+        // Open-addressed, power-of-two sized; a slot with location -1 is empty
+        std::vector<UniformSlot> m_uniformSlots{};
 
         static void setUniform(GLint location, GLint value);
         static void setUniform(GLint location, GLfloat value);
@@ -98,11 +161,53 @@ namespace csv
 
         void link() const;
 
-        void linkAndValidate() const;
+        void linkAndValidate();
+
+        // Post-link setup, also needed after restoring a program binary
+        void reflect();
+
+        void reflectUniforms();
+
+        // Attaches the shared blocks from uniform_blocks.h that the program declares to their binding points
+        void bindUniformBlocks() const;
+
+        void insertUniform(std::string_view name, GLint location);
+    };
+
+    // Program whose compilation and linkage may still be running in the driver
+    class PendingShaderProgram
+    {
+    public:
+        // Without GL_KHR_parallel_shader_compile the driver cannot be polled, so this is always true
+        [[nodiscard]] bool isReady() const;
+
+        // Waits for the driver and returns the program, throwing if compilation or linkage failed
+        [[nodiscard]] ShaderProgram get();
+
+    private:
+        friend class ShaderProgram;
+
+        ShaderProgramFiles m_files;
+        Shader::Type m_vertexShaderType;
+        Shader::Type m_fragmentShaderType;
+        std::string m_vertexSource;
+        std::string m_fragmentSource;
+        std::uint64_t m_cacheKey;
+        bool m_restoredFromCache{};
+
+        ShaderProgram m_program{};
+        std::optional<Shader> m_vertexShader{};
+        std::optional<Shader> m_fragmentShader{};
+
+        explicit PendingShaderProgram(ShaderProgramFiles files);
+
+        void submitCompilation();
+
+        void submitLinkage();
     };
 
     template<typename... Args>
-    void ShaderProgram::setUniform(const std::string_view name, Args... args) const
+    void ShaderProgram::setUniform(const UniformName name, Args... args) const
     {
         setUniform(getUniformLocation(name), std::forward<Args>(args)...);
     }
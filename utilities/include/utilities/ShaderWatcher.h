@@ -0,0 +1,63 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SHADERWATCHER_H
+#define CONSERVATION_UTILITIES_SHADERWATCHER_H
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stop_token>
+#include <thread>
+#include <vector>
+#include "utilities/ShaderProgram.h"
+
+namespace csv
+{
+    // Rebuilds watched programs when their shader files change on disk. A background thread waits for
+    // file events (inotify on Linux, timestamp polling elsewhere); all GL work happens in update().
+    class ShaderWatcher
+    {
+    public:
+        explicit ShaderWatcher(std::filesystem::path directory);
+
+        ShaderWatcher(const ShaderWatcher& other) = delete;
+        ShaderWatcher(ShaderWatcher&& other) noexcept = delete;
+        ShaderWatcher& operator=(const ShaderWatcher& other) = delete;
+        ShaderWatcher& operator=(ShaderWatcher&& other) noexcept = delete;
+
+        ~ShaderWatcher();
+
+        // program must outlive the watcher; it is replaced in place once a rebuild succeeds
+        void watch(ShaderProgram& program, ShaderProgramFiles files);
+
+        // Call at a frame boundary on the context thread: submits rebuilds for changed files and swaps in
+        // the ones the driver has finished. A failed rebuild is reported and the old program is kept.
+        void update();
+
+    private:
+        struct WatchedProgram
+        {
+            ShaderProgram* program;
+            ShaderProgramFiles files;
+            std::optional<PendingShaderProgram> pendingProgram;
+        };
+
+        std::filesystem::path m_directory;
+        std::vector<WatchedProgram> m_programs{};
+
+        std::mutex m_mutex{};
+        std::set<std::filesystem::path> m_changedFiles{};
+
+        int m_inotifyDescriptor{ -1 };
+        std::jthread m_thread{};
+
+        void run(const std::stop_token& stopToken);
+
+        void markChanged(const std::filesystem::path& filename);
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SHADERWATCHER_H
@@ -0,0 +1,84 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SIMULATIONTHREAD_H
+#define CONSERVATION_UTILITIES_SIMULATIONTHREAD_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <thread>
+#include <glm/glm.hpp>
+#include "utilities/FixedTimestep.h"
+#include "utilities/ParticleSystem.h"
+#include "utilities/TripleBuffer.h"
+
+namespace csv
+{
+    // Everything the renderer needs from one simulation step, copied out of the particle system once
+    struct SimulationSnapshot
+    {
+        std::uint64_t step{};
+        double time{};
+        double stepSeconds{};
+        // Wall-clock time at which this state was due; frames interpolate towards it over the following step
+        std::chrono::steady_clock::time_point dueTime{};
+
+        AlignedVector<glm::vec2> positions{};
+        AlignedVector<glm::vec2> previousPositions{};
+        AlignedVector<float> radii{};
+        AlignedVector<glm::vec4> colors{};
+
+        // Blend factor from previousPositions to positions for a frame shown at frameTime
+        [[nodiscard]] float getInterpolation(std::chrono::steady_clock::time_point frameTime) const noexcept;
+    };
+
+    // Steps a particle system at a fixed rate on its own thread, publishing a snapshot after every batch of steps.
+    // The particles belong to the thread; other threads only ever see snapshots
+    class SimulationThread
+    {
+    public:
+        // Advances the particles by one step of the given length. Runs on the simulation thread
+        using StepFunction = std::function<void(ParticleSystem&, float)>;
+
+        SimulationThread(ParticleSystem particles,
+                         StepFunction stepFunction,
+                         double stepSeconds,
+                         std::size_t maxStepsPerBatch = 8);
+
+        SimulationThread(const SimulationThread& other) = delete;
+        SimulationThread(SimulationThread&& other) noexcept = delete;
+        SimulationThread& operator=(const SimulationThread& other) = delete;
+        SimulationThread& operator=(SimulationThread&& other) noexcept = delete;
+
+        ~SimulationThread();
+
+        // Newest completed snapshot, without waiting. Must be called from one thread only; the reference stays
+        // valid and unchanged until the next call
+        [[nodiscard]] const SimulationSnapshot& getLatestSnapshot() noexcept;
+
+        // Steps dropped because the simulation could not keep up with real time
+        [[nodiscard]] std::uint64_t getDroppedSteps() const noexcept;
+
+    private:
+        ParticleSystem m_particles;
+        StepFunction m_stepFunction;
+        FixedTimestep m_timestep;
+        std::uint64_t m_step{};
+        double m_time{};
+        std::atomic<std::uint64_t> m_droppedSteps{};
+        TripleBuffer<SimulationSnapshot> m_snapshots{};
+        // Declared last so that the thread stops before anything it uses is destroyed
+        std::jthread m_thread{};
+
+        void run(const std::stop_token& stopToken);
+
+        void publish(std::chrono::steady_clock::time_point dueTime);
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SIMULATIONTHREAD_H
@@ -0,0 +1,59 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SPSCQUEUE_H
+#define CONSERVATION_UTILITIES_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include "utilities/AlignedAllocator.h"
+
+namespace csv
+{
+    // Bounded first-in first-out queue for exactly one producing and one consuming thread, without locks. Each
+    // side writes only its own index, so an operation is a plain copy and one release store
+    template<typename T, std::size_t Capacity>
+        requires std::is_trivially_copyable_v<T> && ((Capacity & (Capacity - 1)) == 0)
+    class SpscQueue
+    {
+    public:
+        // Producer only; false if the queue is full
+        bool push(const T& value) noexcept
+        {
+            const auto tail{ m_tail.load(std::memory_order_relaxed) };
+            if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+            m_items[tail & MASK] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only
+        std::optional<T> pop() noexcept
+        {
+            const auto head{ m_head.load(std::memory_order_relaxed) };
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return std::nullopt;
+            }
+            const auto value{ m_items[head & MASK] };
+            m_head.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+    private:
+        static constexpr std::size_t MASK{ Capacity - 1 };
+
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head{};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail{};
+        alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_items{};
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SPSCQUEUE_H
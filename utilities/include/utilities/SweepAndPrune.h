@@ -0,0 +1,52 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SWEEPANDPRUNE_H
+#define CONSERVATION_UTILITIES_SWEEPANDPRUNE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utilities/ParticleSystem.h"
+#include "utilities/broadphase.h"
+
+namespace csv
+{
+    // Single-axis sweep-and-prune. Intervals are kept sorted by their lower bound across calls and re-sorted
+    // with an insertion sort, which is close to linear when particles move little between steps. Unlike a
+    // uniform grid its cost does not depend on the spread of radii
+    class SweepAndPrune
+    {
+    public:
+        // Replaces the contents of pairs with every pair of particles whose bounding boxes overlap
+        void findPairs(const ParticleSystem& particles, std::vector<CandidatePair>& pairs);
+
+        // Number of element moves made by the last incremental sort, a measure of temporal coherence
+        [[nodiscard]] std::size_t getLastSortMoves() const noexcept;
+
+    private:
+        struct Interval
+        {
+            float lower;
+            float upper;
+            // Extent on the other axis, checked before a pair is emitted
+            float crossLower;
+            float crossUpper;
+            std::uint32_t index;
+        };
+
+        // Sweep order from the previous call; rebuilt from scratch when the particle count changes
+        std::vector<Interval> m_intervals{};
+        int m_axis{};
+        std::size_t m_lastSortMoves{};
+
+        void rebuild(const ParticleSystem& particles);
+
+        void refresh(const ParticleSystem& particles) noexcept;
+
+        void insertionSort() noexcept;
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SWEEPANDPRUNE_H
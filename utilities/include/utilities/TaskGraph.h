@@ -0,0 +1,268 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_TASKGRAPH_H
+#define CONSERVATION_UTILITIES_TASKGRAPH_H
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "utilities/JobSystem.h"
+
+namespace csv
+{
+    // Graph of coroutine tasks with explicit dependencies, declared once and run as a whole, typically every frame.
+    // A task starts once all of its dependencies have finished. Any tasks run on the job system's workers and Context
+    // tasks on the thread that calls run(), which owns the GL context. Inside a task, co_await resumeOn(...) moves
+    // the rest of the body to the other kind of thread, so one task can claim buffers with GL, fill them on a worker
+    // and publish them with GL again
+    class TaskGraph
+    {
+    public:
+        enum class Affinity
+        {
+            Any,
+            Context
+        };
+
+        using TaskId = std::size_t;
+
+        // Return type of task bodies; created suspended and resumed by the graph
+        class Task
+        {
+        public:
+            struct promise_type
+            {
+                TaskGraph* graph{};
+                TaskId id{};
+
+                // Records when the body first runs
+                struct StartAwaiter
+                {
+                    promise_type& promise;
+
+                    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                    void await_suspend(std::coroutine_handle<>) const noexcept {}
+
+                    void await_resume() const noexcept { promise.graph->onStarted(promise.id); }
+                };
+
+                // Releases the task's successors once the body has returned
+                struct FinishAwaiter
+                {
+                    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                    void await_suspend(const std::coroutine_handle<promise_type> handle) const noexcept
+                    {
+                        handle.promise().graph->onFinished(handle.promise().id);
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+
+                Task get_return_object() noexcept
+                {
+                    return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+
+                StartAwaiter initial_suspend() noexcept { return { *this }; }
+
+                FinishAwaiter final_suspend() noexcept { return {}; }
+
+                void return_void() noexcept {}
+
+                void unhandled_exception() noexcept { graph->onException(std::current_exception()); }
+            };
+
+            Task() noexcept = default;
+
+            Task(const Task& other) = delete;
+            Task& operator=(const Task& other) = delete;
+
+            Task(Task&& other) noexcept
+                : m_handle{ std::exchange(other.m_handle, nullptr) }
+            {
+            }
+
+            Task& operator=(Task&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (m_handle)
+                    {
+                        m_handle.destroy();
+                    }
+                    m_handle = std::exchange(other.m_handle, nullptr);
+                }
+                return *this;
+            }
+
+            ~Task()
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                }
+            }
+
+        private:
+            friend class TaskGraph;
+
+            std::coroutine_handle<promise_type> m_handle{};
+
+            explicit Task(const std::coroutine_handle<promise_type> handle) noexcept
+                : m_handle{ handle }
+            {
+            }
+        };
+
+        // Awaitable returned by resumeOn
+        class ThreadSwitch
+        {
+        public:
+            [[nodiscard]] bool await_ready() const noexcept { return m_graph.isOn(m_affinity); }
+
+            bool await_suspend(const std::coroutine_handle<Task::promise_type> handle)
+            {
+                return m_graph.switchTo(handle.promise().id, m_affinity);
+            }
+
+            void await_resume() const noexcept {}
+
+        private:
+            friend class TaskGraph;
+
+            TaskGraph& m_graph;
+            Affinity m_affinity;
+
+            ThreadSwitch(TaskGraph& graph, const Affinity affinity) noexcept
+                : m_graph{ graph }
+                , m_affinity{ affinity }
+            {
+            }
+        };
+
+        // One task of the most recent run, in milliseconds since the run began
+        struct TaskTiming
+        {
+            std::string_view name;
+            Affinity affinity;
+            // When the last dependency finished
+            double readyMilliseconds;
+            double startMilliseconds;
+            double finishMilliseconds;
+            // Times the body moved between worker and context threads
+            std::size_t threadSwitches;
+            // On the chain of last-finishing dependencies that ends at the last task to finish
+            bool isCritical;
+        };
+
+        // Without a job system, or one without workers, every task runs on the context thread
+        explicit TaskGraph(JobSystem* jobSystem = nullptr);
+
+        TaskGraph(const TaskGraph& other) = delete;
+        TaskGraph(TaskGraph&& other) noexcept = delete;
+        TaskGraph& operator=(const TaskGraph& other) = delete;
+        TaskGraph& operator=(TaskGraph&& other) noexcept = delete;
+
+        ~TaskGraph();
+
+        // Adds a task whose body is created by calling function at every run. Dependencies must already be in the
+        // graph, which keeps it acyclic; the function must outlive the graph's runs, as must anything it captures
+        TaskId add(std::string name,
+                   Affinity affinity,
+                   std::function<Task()> function,
+                   std::initializer_list<TaskId> dependencies = {});
+
+        // Runs every task once and returns when all have finished; the calling thread serves as the context thread
+        // and, while it waits, resumes tasks it queued that no worker has taken. Rethrows the first exception that
+        // escaped a task body
+        void run();
+
+        // Awaited inside a task body, continues it on a thread of the given affinity; no-op if already on one
+        [[nodiscard]] ThreadSwitch resumeOn(Affinity affinity) noexcept;
+
+        // Timings of the last run, in the order the tasks were added
+        [[nodiscard]] std::span<const TaskTiming> getTimings() const noexcept;
+
+        // Graphviz description of the graph annotated with the last run's timings, critical path in red
+        [[nodiscard]] std::string toDot() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Node
+        {
+            std::string name;
+            Affinity affinity;
+            std::function<Task()> function;
+            std::vector<TaskId> dependencies;
+            std::vector<TaskId> successors{};
+            // Resumes the body on a worker
+            JobSystem::Job job{};
+            Task task{};
+            std::atomic<std::size_t> waitingOn{};
+            Clock::time_point readyTime{};
+            Clock::time_point startTime{};
+            Clock::time_point finishTime{};
+            std::size_t threadSwitches{};
+        };
+
+        JobSystem* m_jobSystem;
+        // Nodes never move, since workers hold pointers to their jobs
+        std::vector<std::unique_ptr<Node>> m_nodes{};
+        std::vector<TaskTiming> m_timings{};
+
+        std::thread::id m_contextThread{};
+        Clock::time_point m_runStart{};
+        std::atomic<std::size_t> m_remaining{};
+
+        // Guards the two members below
+        std::mutex m_mutex{};
+        std::deque<TaskId> m_contextQueue{};
+        std::exception_ptr m_exception{};
+
+        [[nodiscard]] bool hasWorkers() const noexcept;
+
+        [[nodiscard]] bool isOn(Affinity affinity) const noexcept;
+
+        // Queues a task to be resumed on a thread of the given affinity
+        void enqueue(TaskId id, Affinity affinity);
+
+        // Returns false if the task could not be handed over and should continue on the current thread
+        bool switchTo(TaskId id, Affinity affinity);
+
+        [[nodiscard]] std::optional<TaskId> takeContextTask();
+
+        void onStarted(TaskId id) noexcept;
+
+        void onFinished(TaskId id) noexcept;
+
+        void onException(std::exception_ptr exception) noexcept;
+
+        void collectTimings();
+
+        // Of the given tasks, the one that finished last in the last run
+        [[nodiscard]] TaskId latestFinished(std::span<const TaskId> ids) const;
+
+        static void resumeTask(const void* node, std::size_t);
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_TASKGRAPH_H
@@ -0,0 +1,70 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_TRIPLEBUFFER_H
+#define CONSERVATION_UTILITIES_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "utilities/AlignedAllocator.h"
+
+namespace csv
+{
+    // Hands whole values from one writing thread to one reading thread without locks or waiting. The writer fills
+    // its own buffer and swaps it with the shared middle one; the reader swaps its buffer with the middle only
+    // when the middle holds something newer. Neither side ever sees a buffer the other is using
+    template<typename T>
+    class TripleBuffer
+    {
+    public:
+        // Writer only; contents are whatever was last written to this buffer, two publishes ago
+        [[nodiscard]] T& getWriteBuffer() noexcept
+        {
+            return m_buffers[m_writeIndex].value;
+        }
+
+        // Writer only; makes the write buffer the newest value and takes over a stale one
+        void publish() noexcept
+        {
+            const auto previous{ m_middle.exchange(m_writeIndex | FRESH, std::memory_order_acq_rel) };
+            m_writeIndex = previous & INDEX_MASK;
+        }
+
+        // Reader only; moves to the newest published value if there is one, and reports whether it did
+        bool update() noexcept
+        {
+            if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+            {
+                return false;
+            }
+            const auto previous{ m_middle.exchange(m_readIndex, std::memory_order_acq_rel) };
+            m_readIndex = previous & INDEX_MASK;
+            return true;
+        }
+
+        // Reader only; unchanged until the next update
+        [[nodiscard]] const T& getReadBuffer() const noexcept
+        {
+            return m_buffers[m_readIndex].value;
+        }
+
+    private:
+        static constexpr std::uint8_t INDEX_MASK{ 0x3 };
+        // Set in the middle index when it holds a value the reader has not taken yet
+        static constexpr std::uint8_t FRESH{ 0x4 };
+
+        struct alignas(CACHE_LINE_SIZE) Buffer
+        {
+            T value{};
+        };
+
+        std::array<Buffer, 3> m_buffers{};
+        alignas(CACHE_LINE_SIZE) std::uint8_t m_writeIndex{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint8_t> m_middle{ 1 };
+        alignas(CACHE_LINE_SIZE) std::uint8_t m_readIndex{ 2 };
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_TRIPLEBUFFER_H
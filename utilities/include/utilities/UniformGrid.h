@@ -0,0 +1,74 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_UNIFORMGRID_H
+#define CONSERVATION_UTILITIES_UNIFORMGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+#include "utilities/broadphase.h"
+
+namespace csv
+{
+    // Cell-list broadphase rebuilt from scratch every call. Particles are bucketed with a counting sort into
+    // flat cell offset and index arrays, so a rebuild is a few linear passes with no per-cell allocations.
+    // Best suited to particles of similar size; the cell edge is at least the largest diameter
+    class UniformGrid
+    {
+    public:
+        // A cellSize of zero sizes the cells from the largest radius on every rebuild
+        explicit UniformGrid(float cellSize = 0.0f) noexcept;
+
+        // Replaces the contents of pairs with every pair of particles whose bounding boxes overlap
+        void findPairs(const ParticleSystem& particles, std::vector<CandidatePair>& pairs);
+
+        // Spreads cell location and the pair search across worker threads; null runs everything on the caller
+        void setJobSystem(JobSystem* jobSystem) noexcept;
+
+        [[nodiscard]] float getCellSize() const noexcept;
+
+        [[nodiscard]] glm::uvec2 getDimensions() const noexcept;
+
+    private:
+        float m_requestedCellSize;
+        JobSystem* m_jobSystem{ nullptr };
+        float m_cellSize{};
+        glm::vec2 m_origin{};
+        std::uint32_t m_columns{};
+        std::uint32_t m_rows{};
+
+        // Particles of cell c occupy slots m_cellStarts[c] to m_cellStarts[c + 1] - 1 of m_sortedParticles
+        std::vector<std::uint32_t> m_cellStarts{};
+        std::vector<std::uint32_t> m_cellCursors{};
+        std::vector<std::uint32_t> m_particleCells{};
+        // Particle data copied into cell order and packed into one record, so the scatter touches one cache
+        // line per particle and the pair search reads memory sequentially
+        struct SortedParticle
+        {
+            glm::vec2 position;
+            float radius;
+            std::uint32_t index;
+        };
+
+        AlignedVector<SortedParticle> m_sortedParticles{};
+        // Pairs found by each band of rows in a parallel search, kept to reuse their capacity
+        std::vector<std::vector<CandidatePair>> m_bandPairs{};
+
+        void build(const ParticleSystem& particles);
+
+        void searchRows(std::uint32_t beginRow, std::uint32_t endRow, std::vector<CandidatePair>& pairs) const;
+
+        // Tests the particle in slot against the particles in slots [begin, end)
+        void collideRange(std::uint32_t slot,
+                          std::uint32_t begin,
+                          std::uint32_t end,
+                          std::vector<CandidatePair>& pairs) const;
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_UNIFORMGRID_H
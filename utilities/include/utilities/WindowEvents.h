@@ -0,0 +1,88 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_WINDOWEVENTS_H
+#define CONSERVATION_UTILITIES_WINDOWEVENTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include "utilities/SpscQueue.h"
+
+namespace csv
+{
+    struct WindowEvent
+    {
+        enum class Type : std::uint8_t
+        {
+            FramebufferResize,
+            Key,
+            MouseButton,
+            CursorMove,
+            Scroll
+        };
+
+        Type type;
+        // GLFW key or mouse button, action and modifier bits
+        int code;
+        int action;
+        int modifiers;
+        // Framebuffer size, cursor position or scroll offset
+        glm::dvec2 value;
+    };
+
+    // Everything that happened to the window since the previous frame, with repeated updates merged
+    struct FrameEvents
+    {
+        // Only the final size matters, however many intermediate sizes a resize went through
+        std::optional<glm::ivec2> framebufferSize{};
+        std::optional<glm::dvec2> cursorPosition{};
+        glm::dvec2 scroll{};
+        // Key and mouse button presses, repeats and releases, in the order they happened
+        std::vector<WindowEvent> buttons{};
+        // Events received before merging
+        std::size_t receivedCount{};
+
+        [[nodiscard]] bool wasKeyPressed(int key) const noexcept;
+    };
+
+    // Owns the window's GLFW callbacks and the window user pointer. Callbacks only record events into a lock-free
+    // queue, so the thread polling GLFW never does work on behalf of the frame, which may run on another thread
+    class WindowEvents
+    {
+    public:
+        // Events that can wait for one drain before further ones are dropped
+        static constexpr std::size_t QUEUE_CAPACITY{ 4096 };
+
+        explicit WindowEvents(GLFWwindow* window);
+
+        WindowEvents(const WindowEvents& other) = delete;
+        WindowEvents(WindowEvents&& other) noexcept = delete;
+        WindowEvents& operator=(const WindowEvents& other) = delete;
+        WindowEvents& operator=(WindowEvents&& other) noexcept = delete;
+
+        ~WindowEvents();
+
+        // Takes every queued event and merges them; call once at the start of each frame, from one thread. The
+        // result stays valid until the next call
+        const FrameEvents& drain();
+
+        // Events lost because the queue was full
+        [[nodiscard]] std::uint64_t getDroppedCount() const noexcept;
+
+    private:
+        GLFWwindow* m_window;
+        SpscQueue<WindowEvent, QUEUE_CAPACITY> m_queue{};
+        std::atomic<std::uint64_t> m_droppedCount{};
+        FrameEvents m_frameEvents{};
+
+        void push(const WindowEvent& event) noexcept;
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_WINDOWEVENTS_H
@@ -0,0 +1,100 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_WORKSTEALINGDEQUE_H
+#define CONSERVATION_UTILITIES_WORKSTEALINGDEQUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "utilities/AlignedAllocator.h"
+
+namespace csv
+{
+    // Chase-Lev deque of pointers with a fixed capacity, using the memory orderings of Le et al. (2013). The
+    // owning thread pushes and pops at the bottom; any other thread steals from the top
+    template<typename T, std::size_t Capacity>
+        requires ((Capacity & (Capacity - 1)) == 0)
+    class WorkStealingDeque
+    {
+    public:
+        // Owner only; false if the deque is full
+        bool push(T* item) noexcept
+        {
+            const auto bottom{ m_bottom.load(std::memory_order_relaxed) };
+            const auto top{ m_top.load(std::memory_order_acquire) };
+            if (bottom - top >= static_cast<std::int64_t>(Capacity))
+            {
+                return false;
+            }
+
+            m_items[static_cast<std::size_t>(bottom) & MASK].store(item, std::memory_order_relaxed);
+            // Publishes the item to thieves, which acquire the bottom before reading it
+            m_bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Owner only; takes the most recently pushed item
+        T* pop() noexcept
+        {
+            const auto bottom{ m_bottom.load(std::memory_order_relaxed) - 1 };
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top{ m_top.load(std::memory_order_relaxed) };
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            auto* item{ m_items[static_cast<std::size_t>(bottom) & MASK].load(std::memory_order_relaxed) };
+            if (top == bottom)
+            {
+                // Last item: race the thieves for it
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // Any thread; takes the oldest item, or nothing if the deque is empty or another thief won it
+        T* steal() noexcept
+        {
+            auto top{ m_top.load(std::memory_order_acquire) };
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom{ m_bottom.load(std::memory_order_acquire) };
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            auto* item{ m_items[static_cast<std::size_t>(top) & MASK].load(std::memory_order_relaxed) };
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::size_t MASK{ Capacity - 1 };
+
+        // Thieves hammer the top and the owner the bottom, so they live on separate cache lines
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_top{};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_bottom{};
+        alignas(CACHE_LINE_SIZE) std::array<std::atomic<T*>, Capacity> m_items{};
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_WORKSTEALINGDEQUE_H
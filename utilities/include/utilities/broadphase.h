@@ -0,0 +1,32 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_BROADPHASE_H
+#define CONSERVATION_UTILITIES_BROADPHASE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace csv
+{
+    // Two particles whose bounding boxes overlap, with first < second
+    struct CandidatePair
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+
+        constexpr bool operator==(const CandidatePair& other) const noexcept = default;
+    };
+
+    class ParticleSystem;
+
+    // Common interface of the broadphases, so they can be swapped and benchmarked on the same scenes
+    template<typename T>
+    concept Broadphase = requires(T& broadphase, const ParticleSystem& particles, std::vector<CandidatePair>& pairs)
+    {
+        broadphase.findPairs(particles, pairs);
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_BROADPHASE_H
@@ -0,0 +1,54 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_FORCES_H
+#define CONSERVATION_UTILITIES_FORCES_H
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <glm/glm.hpp>
+#include "utilities/JobSystem.h"
+#include "utilities/ParticleSystem.h"
+
+namespace csv
+{
+    // A conservative force: writes the acceleration of every particle and returns the total potential energy
+    template<typename T>
+    concept ForceLaw = requires(T& force, const ParticleSystem& particles, std::span<glm::vec2> accelerations)
+    {
+        { force(particles, accelerations) } -> std::convertible_to<double>;
+    };
+
+    // Pairwise Newtonian gravity with Plummer softening, evaluated directly in O(n^2). Sources are streamed in
+    // tiles that stay in L1 while a block of targets passes over them, and each target sums a tile in SIMD lanes
+    struct DirectGravity
+    {
+        // Sources per tile; three float columns of this length take 12 KiB
+        static constexpr std::size_t TILE_SIZE{ 1024 };
+
+        float gravitationalConstant{ 1.0f };
+        float softening{ 0.01f };
+        // Tiles are summed in float either way; this carries the running totals across tiles in double, so the
+        // rounding error no longer grows with the number of tiles
+        bool accumulateInDouble{ true };
+        // Splits the targets across worker threads when set
+        JobSystem* jobSystem{ nullptr };
+
+        double operator()(const ParticleSystem& particles, std::span<glm::vec2> accelerations) const;
+    };
+
+    // Every particle tied to the origin by a spring proportional to its mass, so all particles oscillate with
+    // angular frequency sqrt(stiffness); O(n) and analytically integrable
+    struct HarmonicWell
+    {
+        float stiffness{ 1.0f };
+
+        double operator()(const ParticleSystem& particles, std::span<glm::vec2> accelerations) const noexcept;
+    };
+
+    [[nodiscard]] double computeKineticEnergy(const ParticleSystem& particles) noexcept;
+} // csv
+
+#endif //CONSERVATION_UTILITIES_FORCES_H
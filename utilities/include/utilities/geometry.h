@@ -0,0 +1,76 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_GEOMETRY_H
+#define CONSERVATION_UTILITIES_GEOMETRY_H
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+#include <ranges>
+#include <glm/glm.hpp>
+
+namespace csv
+{
+    // Generate circle vertices as a triangle fan: the center followed by Segments + 1 rim vertices
+    template<std::floating_point T, std::size_t Segments>
+    constexpr std::array<T, 3 * (Segments + 2)> generateCircle(const T radius)
+    {
+        std::array<T, 3 * (Segments + 2)> vertices{};
+        constexpr auto tau{ static_cast<T>(2) * std::numbers::pi_v<T> };
+
+        for (const auto index : std::views::iota(0uz, Segments + 1))
+        {
+            const auto theta{ tau * static_cast<T>(index) / static_cast<T>(Segments) };
+            vertices[3 + index * 3 + 0] = radius * std::cos(theta);
+            vertices[3 + index * 3 + 1] = radius * std::sin(theta);
+            vertices[3 + index * 3 + 2] = static_cast<T>(0);
+        }
+        return vertices;
+    }
+
+    // Axis-aligned bounding box
+    struct Aabb
+    {
+        glm::vec2 lower;
+        glm::vec2 upper;
+
+        [[nodiscard]] static Aabb fromCircle(const glm::vec2& center, const float radius) noexcept
+        {
+            return { center - glm::vec2{ radius }, center + glm::vec2{ radius } };
+        }
+
+        [[nodiscard]] static Aabb merge(const Aabb& first, const Aabb& second) noexcept
+        {
+            return { glm::min(first.lower, second.lower), glm::max(first.upper, second.upper) };
+        }
+
+        [[nodiscard]] Aabb expanded(const float margin) const noexcept
+        {
+            return { lower - glm::vec2{ margin }, upper + glm::vec2{ margin } };
+        }
+
+        [[nodiscard]] constexpr bool contains(const Aabb& other) const noexcept
+        {
+            return lower.x <= other.lower.x && lower.y <= other.lower.y
+                   && other.upper.x <= upper.x && other.upper.y <= upper.y;
+        }
+
+        [[nodiscard]] constexpr bool overlaps(const Aabb& other) const noexcept
+        {
+            return lower.x <= other.upper.x && other.lower.x <= upper.x
+                   && lower.y <= other.upper.y && other.lower.y <= upper.y;
+        }
+
+        // Half the perimeter, the surface area heuristic's cost measure in two dimensions
+        [[nodiscard]] constexpr float getPerimeter() const noexcept
+        {
+            return (upper.x - lower.x) + (upper.y - lower.y);
+        }
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_GEOMETRY_H
@@ -0,0 +1,29 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_HASH_H
+#define CONSERVATION_UTILITIES_HASH_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace csv
+{
+    inline constexpr std::uint64_t FNV_OFFSET_BASIS{ 0xcbf29ce484222325ull };
+    inline constexpr std::uint64_t FNV_PRIME{ 0x100000001b3ull };
+
+    // 64-bit FNV-1a, usable in constant expressions; pass a previous result as seed to chain inputs
+    [[nodiscard]] constexpr std::uint64_t fnv1a(const std::string_view data,
+                                                std::uint64_t seed = FNV_OFFSET_BASIS) noexcept
+    {
+        for (const auto character : data)
+        {
+            seed ^= static_cast<std::uint8_t>(character);
+            seed *= FNV_PRIME;
+        }
+        return seed;
+    }
+} // csv
+
+#endif //CONSERVATION_UTILITIES_HASH_H
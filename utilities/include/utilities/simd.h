@@ -0,0 +1,70 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SIMD_H
+#define CONSERVATION_UTILITIES_SIMD_H
+
+#include <version>
+
+// C++26 data-parallel types where the standard library ships them (std::simd::vec, P1928 as adopted), otherwise the
+// Parallelism TS v2. Only the common subset is used, through the wrappers below, so callers never depend on which
+// one was picked or on argument-dependent lookup into it
+#if defined(__cpp_lib_simd) && __cpp_lib_simd >= 202411L
+#include <simd>
+#else
+#include <experimental/simd>
+#endif
+
+namespace csv
+{
+#if defined(__cpp_lib_simd) && __cpp_lib_simd >= 202411L
+    template<typename T>
+    using NativeSimd = std::simd::vec<T>;
+
+    // Loads NativeSimd<T>::size() consecutive elements; data needs no particular alignment
+    template<typename T>
+    [[nodiscard]] NativeSimd<T> loadSimd(const T* data) noexcept
+    {
+        return std::simd::unchecked_load<NativeSimd<T>>(data, NativeSimd<T>::size());
+    }
+
+    template<typename Simd>
+    [[nodiscard]] Simd sqrtSimd(const Simd& value) noexcept
+    {
+        return std::simd::sqrt(value);
+    }
+
+    // Sum of all lanes
+    template<typename Simd>
+    [[nodiscard]] typename Simd::value_type reduceSimd(const Simd& value) noexcept
+    {
+        return std::simd::reduce(value);
+    }
+#else
+    template<typename T>
+    using NativeSimd = std::experimental::native_simd<T>;
+
+    // Loads NativeSimd<T>::size() consecutive elements; data needs no particular alignment
+    template<typename T>
+    [[nodiscard]] NativeSimd<T> loadSimd(const T* data) noexcept
+    {
+        return NativeSimd<T>{ data, std::experimental::element_aligned };
+    }
+
+    template<typename Simd>
+    [[nodiscard]] Simd sqrtSimd(const Simd& value) noexcept
+    {
+        return std::experimental::sqrt(value);
+    }
+
+    // Sum of all lanes
+    template<typename Simd>
+    [[nodiscard]] typename Simd::value_type reduceSimd(const Simd& value) noexcept
+    {
+        return std::experimental::reduce(value);
+    }
+#endif
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SIMD_H
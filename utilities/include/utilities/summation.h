@@ -0,0 +1,48 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_SUMMATION_H
+#define CONSERVATION_UTILITIES_SUMMATION_H
+
+#include <cmath>
+#include <concepts>
+
+namespace csv
+{
+    // Neumaier's variant of Kahan summation: carries the rounding error of every addition in a separate term,
+    // so the result is accurate to about one rounding of the true sum regardless of the number of terms
+    template<std::floating_point T>
+    struct CompensatedSum
+    {
+        T sum{};
+        T compensation{};
+
+        constexpr void add(const T value) noexcept
+        {
+            const auto total{ sum + value };
+            if (std::abs(sum) >= std::abs(value))
+            {
+                compensation += (sum - total) + value;
+            }
+            else
+            {
+                compensation += (value - total) + sum;
+            }
+            sum = total;
+        }
+
+        constexpr void add(const CompensatedSum& other) noexcept
+        {
+            add(other.sum);
+            add(other.compensation);
+        }
+
+        [[nodiscard]] constexpr T value() const noexcept
+        {
+            return sum + compensation;
+        }
+    };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_SUMMATION_H
@@ -0,0 +1,25 @@
+//
+// Created by user on 10/16/26.
+//
+
+#ifndef CONSERVATION_UTILITIES_UNIFORM_BLOCKS_H
+#define CONSERVATION_UTILITIES_UNIFORM_BLOCKS_H
+
+#include <array>
+#include <glad/glad.h>
+
+namespace csv
+{
+    // Uniform blocks shared across programs, each bound to a fixed binding point at link time
+    struct UniformBlock
+    {
+        const char* name;
+        GLuint binding;
+    };
+
+    inline constexpr UniformBlock CAMERA_UNIFORM_BLOCK{ "Camera", 0 };
+
+    inline constexpr std::array UNIFORM_BLOCKS{ CAMERA_UNIFORM_BLOCK };
+} // csv
+
+#endif //CONSERVATION_UTILITIES_UNIFORM_BLOCKS_H
@@ -0,0 +1,367 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/BarnesHut.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <utility>
+
+namespace csv
+{
+    namespace
+    {
+        // Spreads the low 16 bits of value into the even bit positions
+        constexpr std::uint32_t spreadBits(std::uint32_t value) noexcept
+        {
+            value &= 0x0000ffffu;
+            value = (value | (value << 8)) & 0x00ff00ffu;
+            value = (value | (value << 4)) & 0x0f0f0f0fu;
+            value = (value | (value << 2)) & 0x33333333u;
+            value = (value | (value << 1)) & 0x55555555u;
+            return value;
+        }
+
+        constexpr std::uint32_t mortonCode(const std::uint32_t x, const std::uint32_t y) noexcept
+        {
+            return spreadBits(x) | (spreadBits(y) << 1);
+        }
+
+        // Particles per job when computing keys and gathering into sorted order
+        constexpr std::size_t KEY_GRAIN{ 16384 };
+
+        // Particles per job in the traversal, each far more expensive than a gather
+        constexpr std::size_t TRAVERSAL_GRAIN{ 1024 };
+
+        // Cells per job when splitting a level of the tree or accumulating its masses
+        constexpr std::size_t SPLIT_GRAIN{ 256 };
+    }
+
+    BarnesHut::BarnesHut(const float openingAngle, const float gravitationalConstant, const float softening) noexcept
+        : m_openingAngle{ openingAngle }
+        , m_gravitationalConstant{ gravitationalConstant }
+        , m_softening{ softening }
+    {
+    }
+
+    double BarnesHut::operator()(const ParticleSystem& particles, const std::span<glm::vec2> accelerations)
+    {
+        if (particles.empty())
+        {
+            m_nodes.clear();
+            return 0.0;
+        }
+
+        sortByMortonCode(particles);
+        accumulateMasses();
+
+        // Consecutive slots are neighbours in space, so each job's traversals share most of their nodes
+        const auto traverseSlots{ [&](const std::size_t begin, const std::size_t end)
+        {
+            auto potentialEnergy{ 0.0 };
+            for (const auto slot : std::views::iota(begin, end))
+            {
+                auto& acceleration{ m_sortedAccelerations[slot] };
+                const auto potential{ traverse(static_cast<std::uint32_t>(slot), acceleration) };
+                potentialEnergy += static_cast<double>(m_sortedMasses[slot]) * potential;
+                accelerations[static_cast<std::uint32_t>(m_keys[slot])] = acceleration * m_gravitationalConstant;
+            }
+            return potentialEnergy;
+        } };
+        const auto potentialEnergy{
+            parallelReduce(m_jobSystem, 0uz, m_keys.size(), TRAVERSAL_GRAIN, 0.0, traverseSlots, std::plus{})
+        };
+        // Every pair was counted from both ends
+        return -0.5 * m_gravitationalConstant * potentialEnergy;
+    }
+
+    void BarnesHut::setOpeningAngle(const float openingAngle) noexcept
+    {
+        m_openingAngle = openingAngle;
+    }
+
+    void BarnesHut::setJobSystem(JobSystem* jobSystem) noexcept
+    {
+        m_jobSystem = jobSystem;
+    }
+
+    float BarnesHut::getOpeningAngle() const noexcept
+    {
+        return m_openingAngle;
+    }
+
+    std::size_t BarnesHut::getNodeCount() const noexcept
+    {
+        return m_nodes.size();
+    }
+
+    void BarnesHut::sortByMortonCode(const ParticleSystem& particles)
+    {
+        const auto positions{ particles.getPositions() };
+        const auto masses{ particles.getMasses() };
+        const auto count{ particles.size() };
+
+        glm::vec2 lower{ std::numeric_limits<float>::max() };
+        glm::vec2 upper{ std::numeric_limits<float>::lowest() };
+        for (const auto& position : positions)
+        {
+            lower = glm::min(lower, position);
+            upper = glm::max(upper, position);
+        }
+        // Square root cell, nudged outwards so the upper edge still quantizes inside the grid
+        const auto rootSize{ std::max({ upper.x - lower.x, upper.y - lower.y, std::numeric_limits<float>::min() })
+                             * (1.0f + 1e-6f) };
+        const auto scale{ static_cast<float>(1u << MAX_DEPTH) / rootSize };
+
+        m_keys.resize(count);
+        parallelFor(m_jobSystem, 0, count, KEY_GRAIN, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (const auto index : std::views::iota(begin, end))
+            {
+                const auto cell{ (positions[index] - lower) * scale };
+                const auto x{ std::min(static_cast<std::uint32_t>(cell.x), (1u << MAX_DEPTH) - 1) };
+                const auto y{ std::min(static_cast<std::uint32_t>(cell.y), (1u << MAX_DEPTH) - 1) };
+                m_keys[index] = static_cast<std::uint64_t>(mortonCode(x, y)) << 32 | index;
+            }
+        });
+
+        // Least significant digit radix sort on the code half of the keys, one byte per pass. Every block of keys
+        // counts its digits, a prefix sum in digit-then-block order turns the counts into write offsets, and the
+        // blocks then scatter independently; blocks stay in order within each digit, so every pass is stable
+        const auto blockCount{ (count + KEY_GRAIN - 1) / KEY_GRAIN };
+        const auto forEachBlock{ [&](const auto& body)
+        {
+            parallelFor(m_jobSystem, 0, blockCount, 1, [&](const std::size_t firstBlock, const std::size_t lastBlock)
+            {
+                for (const auto block : std::views::iota(firstBlock, lastBlock))
+                {
+                    const auto first{ block * KEY_GRAIN };
+                    body(block, std::span{ m_keys }.subspan(first, std::min(KEY_GRAIN, count - first)));
+                }
+            });
+        } };
+        m_scratchKeys.resize(count);
+        m_digitOffsets.resize(blockCount);
+        for (const auto shift : { 32u, 40u, 48u, 56u })
+        {
+            forEachBlock([&](const std::size_t block, const std::span<const std::uint64_t> keys)
+            {
+                auto& counts{ m_digitOffsets[block] };
+                counts.fill(0);
+                for (const auto key : keys)
+                {
+                    ++counts[key >> shift & 0xff];
+                }
+            });
+            auto offset{ 0u };
+            for (const auto digit : std::views::iota(0uz, 256uz))
+            {
+                for (auto& offsets : m_digitOffsets)
+                {
+                    offset += std::exchange(offsets[digit], offset);
+                }
+            }
+            forEachBlock([&](const std::size_t block, const std::span<const std::uint64_t> keys)
+            {
+                auto& offsets{ m_digitOffsets[block] };
+                for (const auto key : keys)
+                {
+                    m_scratchKeys[offsets[key >> shift & 0xff]++] = key;
+                }
+            });
+            std::swap(m_keys, m_scratchKeys);
+        }
+
+        m_sortedCodes.resize(count);
+        m_sortedPositions.resize(count);
+        m_sortedMasses.resize(count);
+        m_sortedAccelerations.resize(count);
+        parallelFor(m_jobSystem, 0, count, KEY_GRAIN, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (const auto slot : std::views::iota(begin, end))
+            {
+                const auto index{ static_cast<std::uint32_t>(m_keys[slot]) };
+                m_sortedCodes[slot] = static_cast<std::uint32_t>(m_keys[slot] >> 32);
+                m_sortedPositions[slot] = positions[index];
+                m_sortedMasses[slot] = masses[index];
+            }
+        });
+
+        buildNodes(rootSize);
+    }
+
+    void BarnesHut::buildNodes(const float rootSize)
+    {
+        m_nodes.clear();
+        m_nodes.push_back({ {}, 0.0f, rootSize, 0, 0, 0, static_cast<std::uint32_t>(m_sortedCodes.size()) });
+        m_levelStarts.assign(1, 0);
+
+        // Breadth first, one level at a time: the particles of a cell are a contiguous run of the sorted codes, and
+        // within it each quadrant is a contiguous run sharing the next two bits. The cells of a level split
+        // independently, and a prefix sum over their child counts lays out the next level in the same order as a
+        // serial breadth-first build
+        for (auto depth{ 0u }; depth < MAX_DEPTH && m_levelStarts.back() < m_nodes.size(); ++depth)
+        {
+            const auto levelBegin{ m_levelStarts.back() };
+            const auto levelEnd{ m_nodes.size() };
+            const auto levelSize{ levelEnd - levelBegin };
+            const auto shift{ 2 * (MAX_DEPTH - 1 - depth) };
+            m_levelStarts.push_back(levelEnd);
+
+            m_quadrantBounds.resize(levelSize);
+            m_childOffsets.resize(levelSize + 1);
+            m_childOffsets[0] = 0;
+            parallelFor(m_jobSystem, 0, levelSize, SPLIT_GRAIN, [&](const std::size_t begin, const std::size_t end)
+            {
+                for (const auto index : std::views::iota(begin, end))
+                {
+                    const auto& node{ m_nodes[levelBegin + index] };
+                    auto& bounds{ m_quadrantBounds[index] };
+                    auto childCount{ 0u };
+                    if (node.end - node.begin > LEAF_SIZE)
+                    {
+                        bounds[0] = node.begin;
+                        for (const auto quadrant : std::views::iota(0u, 4u))
+                        {
+                            const auto first{ bounds[quadrant] };
+                            const auto codes{ std::span{ m_sortedCodes }.subspan(first, node.end - first) };
+                            bounds[quadrant + 1] = first + static_cast<std::uint32_t>(
+                                std::ranges::partition_point(codes, [&](const std::uint32_t code)
+                                {
+                                    return (code >> shift & 3u) <= quadrant;
+                                }) - codes.begin());
+                            childCount += bounds[quadrant + 1] > first ? 1u : 0u;
+                        }
+                    }
+                    m_childOffsets[index + 1] = childCount;
+                }
+            });
+            std::partial_sum(m_childOffsets.begin(), m_childOffsets.end(), m_childOffsets.begin());
+
+            m_nodes.resize(levelEnd + m_childOffsets[levelSize]);
+            parallelFor(m_jobSystem, 0, levelSize, SPLIT_GRAIN, [&](const std::size_t begin, const std::size_t end)
+            {
+                for (const auto index : std::views::iota(begin, end))
+                {
+                    auto& node{ m_nodes[levelBegin + index] };
+                    const auto childCount{ m_childOffsets[index + 1] - m_childOffsets[index] };
+                    if (childCount == 0)
+                    {
+                        continue;
+                    }
+                    const auto firstChild{ static_cast<std::uint32_t>(levelEnd + m_childOffsets[index]) };
+                    node.firstChild = firstChild;
+                    node.childCount = childCount;
+
+                    const auto& bounds{ m_quadrantBounds[index] };
+                    auto child{ firstChild };
+                    for (const auto quadrant : std::views::iota(0u, 4u))
+                    {
+                        if (bounds[quadrant + 1] > bounds[quadrant])
+                        {
+                            const auto childSize{ 0.5f * node.size };
+                            m_nodes[child++] = { {}, 0.0f, childSize, 0, 0, bounds[quadrant], bounds[quadrant + 1] };
+                        }
+                    }
+                }
+            });
+        }
+        if (m_levelStarts.back() < m_nodes.size())
+        {
+            m_levelStarts.push_back(m_nodes.size());
+        }
+    }
+
+    void BarnesHut::accumulateMasses()
+    {
+        // Deepest level first, so every child is complete before its parent; the cells of a level are independent
+        for (const auto level : std::views::iota(0uz, m_levelStarts.size() - 1) | std::views::reverse)
+        {
+            const auto accumulate{ [&](const std::size_t begin, const std::size_t end)
+            {
+                for (auto& node : std::span{ m_nodes }.subspan(begin, end - begin))
+                {
+                    auto mass{ 0.0f };
+                    glm::vec2 weightedPosition{ 0.0f };
+                    if (node.childCount == 0)
+                    {
+                        for (const auto slot : std::views::iota(node.begin, node.end))
+                        {
+                            mass += m_sortedMasses[slot];
+                            weightedPosition += m_sortedPositions[slot] * m_sortedMasses[slot];
+                        }
+                    }
+                    else
+                    {
+                        for (const auto& child : std::span{ m_nodes }.subspan(node.firstChild, node.childCount))
+                        {
+                            mass += child.mass;
+                            weightedPosition += child.centerOfMass * child.mass;
+                        }
+                    }
+                    node.mass = mass;
+                    node.centerOfMass = mass > 0.0f ? weightedPosition / mass : m_sortedPositions[node.begin];
+                }
+            } };
+            parallelFor(m_jobSystem, m_levelStarts[level], m_levelStarts[level + 1], SPLIT_GRAIN, accumulate);
+        }
+    }
+
+    float BarnesHut::traverse(const std::uint32_t slot, glm::vec2& acceleration) const noexcept
+    {
+        const auto position{ m_sortedPositions[slot] };
+        const auto softeningSquared{ m_softening * m_softening };
+        const auto openingAngleSquared{ m_openingAngle * m_openingAngle };
+
+        acceleration = glm::vec2{ 0.0f };
+        auto potential{ 0.0f };
+        const auto attract{ [&](const glm::vec2& source, const float mass)
+        {
+            const auto separation{ source - position };
+            const auto inverseDistance{ 1.0f / std::sqrt(glm::dot(separation, separation) + softeningSquared) };
+            acceleration += separation * (mass * inverseDistance * inverseDistance * inverseDistance);
+            potential += mass * inverseDistance;
+        } };
+
+        // Each level pushes at most four children and pops one
+        std::array<std::uint32_t, 3 * MAX_DEPTH + 4> stack{};
+        auto top{ 0uz };
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const auto& node{ m_nodes[stack[--top]] };
+            if (node.childCount == 0)
+            {
+                for (const auto other : std::views::iota(node.begin, node.end))
+                {
+                    if (other != slot)
+                    {
+                        attract(m_sortedPositions[other], m_sortedMasses[other]);
+                    }
+                }
+                continue;
+            }
+
+            // A cell holding the particle is always opened: its centre of mass can be far enough away to pass the
+            // angle test once the opening angle exceeds 1/sqrt(2), and its mass includes the particle's own
+            const auto separation{ node.centerOfMass - position };
+            const auto containsSlot{ slot >= node.begin && slot < node.end };
+            if (!containsSlot && node.size * node.size < openingAngleSquared * glm::dot(separation, separation))
+            {
+                attract(node.centerOfMass, node.mass);
+                continue;
+            }
+            for (const auto child : std::views::iota(node.firstChild, node.firstChild + node.childCount))
+            {
+                stack[top++] = child;
+            }
+        }
+        return potential;
+    }
+} // csv
@@ -6,6 +6,8 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include "utilities/GlState.h"
+#include "utilities/uniform_blocks.h"
 
 namespace csv
 {
@@ -43,19 +45,32 @@ namespace csv
         return m_projectionMatrix;
     }
 
+    glm::mat4 Camera::getViewProjectionMatrix() const noexcept
+    {
+        return getProjectionMatrix() * getViewMatrix();
+    }
+
+    std::uint64_t Camera::getRevision() const noexcept
+    {
+        return m_revision;
+    }
+
     void Camera::setPosition(const glm::vec3& position) noexcept
     {
         m_position = position;
+        ++m_revision;
     }
 
     void Camera::setTarget(const glm::vec3& target) noexcept
     {
         m_target = target;
+        ++m_revision;
     }
 
     void Camera::setUp(const glm::vec3& up) noexcept
     {
         m_up = up;
+        ++m_revision;
     }
 
     void Camera::setOrthographicProjection(
@@ -75,33 +90,54 @@ namespace csv
         updateProjectionMatrix();
     }
 
+    void Camera::setViewportSize(const glm::ivec2& viewportSize) noexcept
+    {
+        m_viewportSize = glm::max(viewportSize, glm::ivec2{ 1 });
+    }
+
+    glm::ivec2 Camera::getViewportSize() const noexcept
+    {
+        return m_viewportSize;
+    }
+
+    float Camera::getPixelSize() const noexcept
+    {
+        return (m_top - m_bottom) / static_cast<float>(m_viewportSize.y);
+    }
+
     void Camera::updateProjectionMatrix() noexcept
     {
         m_projectionMatrix = glm::ortho(m_left, m_right, m_bottom, m_top, m_near, m_far);
+        ++m_revision;
     }
 
-    CameraSystem::CameraSystem(GLFWwindow* window)
-        : m_window(window)
-        , m_camera(std::make_unique<Camera>())
+    CameraSystem::CameraSystem(const glm::ivec2& framebufferSize)
+        : m_camera(std::make_unique<Camera>())
     {
-        // Set up window resize callback
-        glfwSetWindowUserPointer(window, this);
-        glfwSetFramebufferSizeCallback(window, [](GLFWwindow* win, int width, int height)
-        {
-            const auto* cameraSys = static_cast<CameraSystem*>(glfwGetWindowUserPointer(win));
-            cameraSys->onWindowResize(width, height);
-        });
+        glGenBuffers(1, &m_uniformBuffer);
+        GlState::bindBuffer(GL_UNIFORM_BUFFER, m_uniformBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraUniforms), nullptr, GL_DYNAMIC_DRAW);
+        GlState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+        GlState::bindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BLOCK.binding, m_uniformBuffer);
+
+        resize(framebufferSize);
+        update();
+    }
 
-        // Initialize with current window size
-        int width, height;
-        glfwGetFramebufferSize(window, &width, &height);
-        onWindowResize(width, height);
+    CameraSystem::~CameraSystem()
+    {
+        GlState::onBufferDeleted(m_uniformBuffer);
+        glDeleteBuffers(1, &m_uniformBuffer);
     }
 
-    // ReSharper disable once CppMemberFunctionMayBeStatic
     void CameraSystem::update() noexcept
     {
         // This method can be expanded to include camera movement, zoom, etc.
+        if (m_camera->getRevision() != m_uploadedRevision)
+        {
+            uploadUniforms();
+            m_uploadedRevision = m_camera->getRevision();
+        }
     }
 
     Camera& CameraSystem::getCamera() noexcept
@@ -114,10 +150,30 @@ namespace csv
         return *m_camera;
     }
 
-    void CameraSystem::onWindowResize(const int width, const int height) const noexcept
+    void CameraSystem::uploadUniforms() const noexcept
+    {
+        const CameraUniforms uniforms{
+            m_camera->getViewMatrix(),
+            m_camera->getProjectionMatrix(),
+            m_camera->getViewProjectionMatrix()
+        };
+        GlState::bindBuffer(GL_UNIFORM_BUFFER, m_uniformBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraUniforms), &uniforms);
+    }
+
+    void CameraSystem::resize(const glm::ivec2& framebufferSize) const noexcept
     {
+        // A minimized window has an empty framebuffer; keep the previous projection
+        if (framebufferSize.x <= 0 || framebufferSize.y <= 0)
+        {
+            return;
+        }
+        const auto width{ framebufferSize.x };
+        const auto height{ framebufferSize.y };
+
         // Update viewport
         glViewport(0, 0, width, height);
+        m_camera->setViewportSize({ width, height });
 
         // Update camera projection to maintain aspect ratio
         const float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
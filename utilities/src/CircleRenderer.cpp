@@ -0,0 +1,250 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/CircleRenderer.h"
+
+#include <array>
+#include <cstring>
+#include <print>
+#include <ranges>
+#include "utilities/GlState.h"
+#include "utilities/geometry.h"
+
+namespace csv
+{
+    namespace
+    {
+        void instanceAttribute(const GLuint index,
+                               const GpuRingBuffer& buffer,
+                               const GLintptr offset,
+                               const GLint components)
+        {
+            GlState::bindBuffer(GL_ARRAY_BUFFER, buffer.getId());
+            glVertexAttribPointer(index,
+                                  components,
+                                  GL_FLOAT,
+                                  GL_FALSE,
+                                  components * sizeof(GLfloat),
+                                  reinterpret_cast<const void*>(offset));
+        }
+
+        void enableInstanceAttribute(const GLuint index)
+        {
+            glEnableVertexAttribArray(index);
+            glVertexAttribDivisor(index, 1);
+        }
+    }
+
+    std::size_t CircleInstances::size() const noexcept
+    {
+        return positions.size();
+    }
+
+    void CircleStaging::fill(const CircleInstances& instances,
+                             const std::size_t begin,
+                             const std::size_t end) const noexcept
+    {
+        const auto copy{ [begin, end]<typename T>(const std::span<std::byte> region, const std::span<const T> source)
+        {
+            std::memcpy(region.data() + begin * sizeof(T), source.data() + begin, (end - begin) * sizeof(T));
+        } };
+
+        copy(positions, instances.positions);
+        if (!previousPositions.empty())
+        {
+            copy(previousPositions, instances.previousPositions);
+        }
+        copy(radii, instances.radii);
+        copy(colors, instances.colors);
+    }
+
+    CircleRenderer::CircleRenderer(ShaderProgram meshProgram, ShaderProgram impostorProgram, const Mode mode)
+        : m_meshProgram{ std::move(meshProgram) }
+        , m_impostorProgram{ std::move(impostorProgram) }
+        , m_mode{ mode }
+    {
+        constexpr auto vertices{ generateCircle<float, SEGMENTS>(1.0f) };
+        constexpr std::array corners{ -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+
+        glGenVertexArrays(1, &m_meshVertexArrayObject);
+        glGenVertexArrays(1, &m_impostorVertexArrayObject);
+        glGenBuffers(1, &m_meshBuffer);
+        glGenBuffers(1, &m_quadBuffer);
+
+        GlState::bindVertexArray(m_meshVertexArrayObject);
+        GlState::bindBuffer(GL_ARRAY_BUFFER, m_meshBuffer);
+        glBufferData(GL_ARRAY_BUFFER,
+                     sizeof(std::ranges::range_value_t<decltype(vertices)>) * vertices.size(),
+                     vertices.data(),
+                     GL_STATIC_DRAW);
+        glVertexAttribPointer(0,
+                              3,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              3 * sizeof(std::ranges::range_value_t<decltype(vertices)>),
+                              nullptr);
+        glEnableVertexAttribArray(0);
+        setupInstanceAttributes();
+
+        GlState::bindVertexArray(m_impostorVertexArrayObject);
+        GlState::bindBuffer(GL_ARRAY_BUFFER, m_quadBuffer);
+        glBufferData(GL_ARRAY_BUFFER,
+                     sizeof(std::ranges::range_value_t<decltype(corners)>) * corners.size(),
+                     corners.data(),
+                     GL_STATIC_DRAW);
+        glVertexAttribPointer(0,
+                              2,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              2 * sizeof(std::ranges::range_value_t<decltype(corners)>),
+                              nullptr);
+        glEnableVertexAttribArray(0);
+        setupInstanceAttributes();
+
+        GlState::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GlState::bindVertexArray(0);
+    }
+
+    CircleRenderer::~CircleRenderer()
+    {
+        GlState::onVertexArrayDeleted(m_meshVertexArrayObject);
+        GlState::onVertexArrayDeleted(m_impostorVertexArrayObject);
+        GlState::onBufferDeleted(m_meshBuffer);
+        GlState::onBufferDeleted(m_quadBuffer);
+        glDeleteVertexArrays(1, &m_meshVertexArrayObject);
+        glDeleteVertexArrays(1, &m_impostorVertexArrayObject);
+        glDeleteBuffers(1, &m_meshBuffer);
+        glDeleteBuffers(1, &m_quadBuffer);
+    }
+
+    void CircleRenderer::draw(const CircleInstances& instances, const Camera& camera)
+    {
+        if (instances.radii.size() != instances.size()
+            || instances.colors.size() != instances.size()
+            || (!instances.previousPositions.empty() && instances.previousPositions.size() != instances.size()))
+        {
+            std::println(stderr,
+                         "Mismatched circle instance streams: {} positions, {} radii, {} colors, {} previous positions",
+                         instances.positions.size(),
+                         instances.radii.size(),
+                         instances.colors.size(),
+                         instances.previousPositions.size());
+            throw std::runtime_error("Mismatched circle instance streams");
+        }
+        if (instances.size() == 0)
+        {
+            return;
+        }
+
+        auto staging{ stage(instances.size(), !instances.previousPositions.empty()) };
+        staging.interpolation = instances.interpolation;
+        staging.fill(instances, 0, instances.size());
+        drawStaged(staging, camera);
+    }
+
+    CircleStaging CircleRenderer::stage(const std::size_t count, const bool interpolated)
+    {
+        const auto claim{ [count](GpuRingBuffer& buffer, const std::size_t elementSize)
+        {
+            buffer.reserve(count * elementSize);
+            return buffer.beginWrite().first(count * elementSize);
+        } };
+
+        const auto previousPositions{
+            interpolated ? claim(m_previousPositionBuffer, sizeof(glm::vec2)) : std::span<std::byte>{}
+        };
+        return {
+            .positions = claim(m_positionBuffer, sizeof(glm::vec2)),
+            .previousPositions = previousPositions,
+            .radii = claim(m_radiusBuffer, sizeof(float)),
+            .colors = claim(m_colorBuffer, sizeof(glm::vec4)),
+            .count = count
+        };
+    }
+
+    void CircleRenderer::drawStaged(const CircleStaging& staging, const Camera& camera)
+    {
+        if (staging.count == 0)
+        {
+            return;
+        }
+
+        const auto& program{ getProgram(m_mode) };
+        program.use();
+        program.setUniform("interpolation", staging.interpolation);
+
+        const auto instanceCount{ static_cast<GLsizei>(staging.count) };
+        switch (m_mode)
+        {
+            case Mode::Mesh:
+                GlState::setBlending(false);
+                GlState::bindVertexArray(m_meshVertexArrayObject);
+                upload(staging);
+                glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, SEGMENTS + 2, instanceCount);
+                break;
+            case Mode::Impostor:
+                program.setUniform("pixelSize", camera.getPixelSize());
+                GlState::setBlending(true);
+                GlState::setBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                GlState::bindVertexArray(m_impostorVertexArrayObject);
+                upload(staging);
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instanceCount);
+                break;
+        }
+
+        m_positionBuffer.fence();
+        if (!staging.previousPositions.empty())
+        {
+            m_previousPositionBuffer.fence();
+        }
+        m_radiusBuffer.fence();
+        m_colorBuffer.fence();
+    }
+
+    void CircleRenderer::setMode(const Mode mode) noexcept
+    {
+        m_mode = mode;
+    }
+
+    CircleRenderer::Mode CircleRenderer::getMode() const noexcept
+    {
+        return m_mode;
+    }
+
+    ShaderProgram& CircleRenderer::getProgram(const Mode mode) noexcept
+    {
+        return mode == Mode::Mesh ? m_meshProgram : m_impostorProgram;
+    }
+
+    void CircleRenderer::setupInstanceAttributes() const
+    {
+        instanceAttribute(1, m_positionBuffer, 0, 2);
+        instanceAttribute(2, m_radiusBuffer, 0, 1);
+        instanceAttribute(3, m_colorBuffer, 0, 4);
+        instanceAttribute(4, m_previousPositionBuffer, 0, 2);
+        enableInstanceAttribute(1);
+        enableInstanceAttribute(2);
+        enableInstanceAttribute(3);
+        enableInstanceAttribute(4);
+    }
+
+    void CircleRenderer::upload(const CircleStaging& staging)
+    {
+        const auto positionOffset{ m_positionBuffer.endWrite(staging.positions.size()) };
+        instanceAttribute(1, m_positionBuffer, positionOffset, 2);
+        if (staging.previousPositions.empty())
+        {
+            instanceAttribute(4, m_positionBuffer, positionOffset, 2);
+        }
+        else
+        {
+            instanceAttribute(4,
+                              m_previousPositionBuffer,
+                              m_previousPositionBuffer.endWrite(staging.previousPositions.size()),
+                              2);
+        }
+        instanceAttribute(2, m_radiusBuffer, m_radiusBuffer.endWrite(staging.radii.size()), 1);
+        instanceAttribute(3, m_colorBuffer, m_colorBuffer.endWrite(staging.colors.size()), 4);
+    }
+} // csv
@@ -0,0 +1,164 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/ConservationDiagnostics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ranges>
+#include "utilities/summation.h"
+
+namespace csv
+{
+    namespace
+    {
+        // Independent accumulators per chunk so the inner loop has no loop-carried dependency on one sum
+        constexpr std::size_t LANES{ 8 };
+
+        struct ChunkTotals
+        {
+            double kineticEnergy{};
+            double momentumX{};
+            double momentumY{};
+            double angularMomentum{};
+        };
+
+        // Single pass over one chunk; float products are widened to double, which is exact enough for a chunk
+        ChunkTotals reduceChunk(const ParticleSystem& particles, const std::size_t begin, const std::size_t end) noexcept
+        {
+            const auto positions{ particles.getPositions() };
+            const auto velocities{ particles.getVelocities() };
+            const auto masses{ particles.getMasses() };
+
+            std::array<double, LANES> kineticEnergy{};
+            std::array<double, LANES> momentumX{};
+            std::array<double, LANES> momentumY{};
+            std::array<double, LANES> angularMomentum{};
+
+            const auto accumulate{ [&](const std::size_t index, const std::size_t lane)
+            {
+                const auto mass{ static_cast<double>(masses[index]) };
+                const glm::dvec2 position{ positions[index] };
+                const glm::dvec2 velocity{ velocities[index] };
+                kineticEnergy[lane] += mass * glm::dot(velocity, velocity);
+                momentumX[lane] += mass * velocity.x;
+                momentumY[lane] += mass * velocity.y;
+                angularMomentum[lane] += mass * (position.x * velocity.y - position.y * velocity.x);
+            } };
+
+            auto index{ begin };
+            for (; index + LANES <= end; index += LANES)
+            {
+                for (const auto lane : std::views::iota(0uz, LANES))
+                {
+                    accumulate(index + lane, lane);
+                }
+            }
+            for (auto lane{ 0uz }; index < end; ++index, ++lane)
+            {
+                accumulate(index, lane);
+            }
+
+            const auto total{ [](const std::array<double, LANES>& lanes)
+            {
+                CompensatedSum<double> sum{};
+                for (const auto value : lanes)
+                {
+                    sum.add(value);
+                }
+                return sum.value();
+            } };
+            return { 0.5 * total(kineticEnergy), total(momentumX), total(momentumY), total(angularMomentum) };
+        }
+
+        struct RunningTotals
+        {
+            CompensatedSum<double> kineticEnergy{};
+            CompensatedSum<double> momentumX{};
+            CompensatedSum<double> momentumY{};
+            CompensatedSum<double> angularMomentum{};
+
+            RunningTotals& add(const ChunkTotals& chunk) noexcept
+            {
+                kineticEnergy.add(chunk.kineticEnergy);
+                momentumX.add(chunk.momentumX);
+                momentumY.add(chunk.momentumY);
+                angularMomentum.add(chunk.angularMomentum);
+                return *this;
+            }
+
+            RunningTotals& add(const RunningTotals& other) noexcept
+            {
+                kineticEnergy.add(other.kineticEnergy);
+                momentumX.add(other.momentumX);
+                momentumY.add(other.momentumY);
+                angularMomentum.add(other.angularMomentum);
+                return *this;
+            }
+        };
+    }
+
+    const ConservationSample& ConservationDiagnostics::record(const ParticleSystem& particles,
+                                                              const double potentialEnergy,
+                                                              const double time)
+    {
+        // Chunks are reduced in parallel but merged in order, so a sample does not depend on the thread count
+        const auto totals{ parallelReduce(m_jobSystem,
+                                          0uz,
+                                          particles.size(),
+                                          CHUNK_SIZE,
+                                          RunningTotals{},
+                                          [&](const std::size_t begin, const std::size_t end)
+                                          {
+                                              return RunningTotals{}.add(reduceChunk(particles, begin, end));
+                                          },
+                                          [](RunningTotals result, const RunningTotals& chunk)
+                                          {
+                                              return result.add(chunk);
+                                          }) };
+        const auto& [kineticEnergy, momentumX, momentumY, angularMomentum]{ totals };
+
+        m_lastSample = {
+            .step = m_step++,
+            .time = time,
+            .kineticEnergy = kineticEnergy.value(),
+            .potentialEnergy = potentialEnergy,
+            .totalEnergy = kineticEnergy.value() + potentialEnergy,
+            .linearMomentum = { momentumX.value(), momentumY.value() },
+            .angularMomentum = angularMomentum.value()
+        };
+        if (!m_initialSample)
+        {
+            m_initialSample = m_lastSample;
+        }
+        m_lastSample.relativeEnergyDrift = getRelativeEnergyDrift(m_lastSample);
+        m_history.push(m_lastSample);
+        return m_lastSample;
+    }
+
+    void ConservationDiagnostics::setJobSystem(JobSystem* jobSystem) noexcept
+    {
+        m_jobSystem = jobSystem;
+    }
+
+    const ConservationDiagnostics::History& ConservationDiagnostics::getHistory() const noexcept
+    {
+        return m_history;
+    }
+
+    const std::optional<ConservationSample>& ConservationDiagnostics::getInitialSample() const noexcept
+    {
+        return m_initialSample;
+    }
+
+    double ConservationDiagnostics::getRelativeEnergyDrift(const ConservationSample& sample) const noexcept
+    {
+        if (!m_initialSample || m_initialSample->totalEnergy == 0.0)
+        {
+            return 0.0;
+        }
+        return (sample.totalEnergy - m_initialSample->totalEnergy) / std::abs(m_initialSample->totalEnergy);
+    }
+} // csv
@@ -0,0 +1,393 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/DynamicAabbTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ranges>
+#include <utility>
+
+namespace csv
+{
+    DynamicAabbTree::DynamicAabbTree(const float fatMargin) noexcept
+        : m_fatMargin{ fatMargin }
+    {
+    }
+
+    void DynamicAabbTree::update(const ParticleSystem& particles)
+    {
+        const auto positions{ particles.getPositions() };
+        const auto radii{ particles.getRadii() };
+        const auto count{ particles.size() };
+
+        while (m_leaves.size() > count)
+        {
+            removeLeaf(m_leaves.back());
+            freeNode(m_leaves.back());
+            m_leaves.pop_back();
+        }
+        m_particleBounds.resize(count);
+
+        for (const auto index : std::views::iota(0uz, count))
+        {
+            const auto bounds{ Aabb::fromCircle(positions[index], radii[index]) };
+            m_particleBounds[index] = bounds;
+
+            if (index == m_leaves.size())
+            {
+                const auto leaf{ allocateNode() };
+                m_nodes[leaf].particle = static_cast<std::uint32_t>(index);
+                m_nodes[leaf].bounds = bounds.expanded(m_fatMargin * radii[index]);
+                m_leaves.push_back(leaf);
+                insertLeaf(leaf);
+            }
+            else if (const auto leaf{ m_leaves[index] }; !m_nodes[leaf].bounds.contains(bounds))
+            {
+                removeLeaf(leaf);
+                m_nodes[leaf].bounds = bounds.expanded(m_fatMargin * radii[index]);
+                insertLeaf(leaf);
+            }
+        }
+    }
+
+    void DynamicAabbTree::findPairs(const ParticleSystem& particles, std::vector<CandidatePair>& pairs)
+    {
+        pairs.clear();
+        update(particles);
+        if (m_root == NULL_NODE)
+        {
+            return;
+        }
+
+        // Collide the tree with itself: a node against itself splits into its children against themselves and
+        // each other, and two overlapping nodes split the larger one. Each overlapping pair is reached once
+        m_pairStack.clear();
+        m_pairStack.emplace_back(m_root, m_root);
+        while (!m_pairStack.empty())
+        {
+            const auto [first, second]{ m_pairStack.back() };
+            m_pairStack.pop_back();
+            const auto& firstNode{ m_nodes[first] };
+            const auto& secondNode{ m_nodes[second] };
+
+            if (first == second)
+            {
+                if (!firstNode.isLeaf())
+                {
+                    m_pairStack.emplace_back(firstNode.firstChild, firstNode.firstChild);
+                    m_pairStack.emplace_back(firstNode.secondChild, firstNode.secondChild);
+                    m_pairStack.emplace_back(firstNode.firstChild, firstNode.secondChild);
+                }
+                continue;
+            }
+            if (!firstNode.bounds.overlaps(secondNode.bounds))
+            {
+                continue;
+            }
+
+            if (firstNode.isLeaf() && secondNode.isLeaf())
+            {
+                if (m_particleBounds[firstNode.particle].overlaps(m_particleBounds[secondNode.particle]))
+                {
+                    pairs.push_back({ std::min(firstNode.particle, secondNode.particle),
+                                      std::max(firstNode.particle, secondNode.particle) });
+                }
+            }
+            else if (secondNode.isLeaf()
+                     || (!firstNode.isLeaf() && firstNode.bounds.getPerimeter() >= secondNode.bounds.getPerimeter()))
+            {
+                m_pairStack.emplace_back(firstNode.firstChild, second);
+                m_pairStack.emplace_back(firstNode.secondChild, second);
+            }
+            else
+            {
+                m_pairStack.emplace_back(first, secondNode.firstChild);
+                m_pairStack.emplace_back(first, secondNode.secondChild);
+            }
+        }
+    }
+
+    void DynamicAabbTree::queryRegion(const Aabb& region, std::vector<std::uint32_t>& particles) const
+    {
+        query(region, [&](const std::uint32_t particle)
+        {
+            if (region.overlaps(m_particleBounds[particle]))
+            {
+                particles.push_back(particle);
+            }
+        });
+    }
+
+    std::optional<RayHit> DynamicAabbTree::raycast(const glm::vec2& origin,
+                                                    const glm::vec2& direction,
+                                                    const float maxDistance) const
+    {
+        std::optional<RayHit> hit{};
+        if (m_root == NULL_NODE)
+        {
+            return hit;
+        }
+
+        const glm::vec2 inverseDirection{ 1.0f / direction.x, 1.0f / direction.y };
+        auto nearest{ maxDistance };
+
+        // Slab test; a box is only worth visiting if the ray enters it before the nearest hit so far
+        const auto entersBefore{ [&](const Aabb& bounds, const float distance)
+        {
+            const auto first{ (bounds.lower - origin) * inverseDirection };
+            const auto second{ (bounds.upper - origin) * inverseDirection };
+            const auto entry{ std::max(std::min(first.x, second.x), std::min(first.y, second.y)) };
+            const auto exit{ std::min(std::max(first.x, second.x), std::max(first.y, second.y)) };
+            return entry <= exit && exit >= 0.0f && entry <= distance;
+        } };
+
+        m_stack.clear();
+        m_stack.push_back(m_root);
+        while (!m_stack.empty())
+        {
+            const auto& node{ m_nodes[m_stack.back()] };
+            m_stack.pop_back();
+            if (!entersBefore(node.bounds, nearest))
+            {
+                continue;
+            }
+            if (!node.isLeaf())
+            {
+                m_stack.push_back(node.firstChild);
+                m_stack.push_back(node.secondChild);
+                continue;
+            }
+
+            // The tight bounds of a particle are the square around its circle
+            const auto& bounds{ m_particleBounds[node.particle] };
+            const auto center{ 0.5f * (bounds.lower + bounds.upper) };
+            const auto radius{ 0.5f * (bounds.upper.x - bounds.lower.x) };
+            const auto offset{ origin - center };
+            const auto halfB{ glm::dot(offset, direction) };
+            const auto discriminant{ halfB * halfB - (glm::dot(offset, offset) - radius * radius) };
+            if (discriminant < 0.0f)
+            {
+                continue;
+            }
+            // Entry distance, or zero when the ray starts inside the circle
+            const auto distance{ std::max(-halfB - std::sqrt(discriminant), 0.0f) };
+            if (distance <= nearest && -halfB + std::sqrt(discriminant) >= 0.0f)
+            {
+                nearest = distance;
+                hit = RayHit{ node.particle, distance };
+            }
+        }
+        return hit;
+    }
+
+    std::int32_t DynamicAabbTree::getHeight() const noexcept
+    {
+        return m_root == NULL_NODE ? 0 : m_nodes[m_root].height;
+    }
+
+    std::size_t DynamicAabbTree::getNodeCount() const noexcept
+    {
+        return m_nodeCount;
+    }
+
+    std::int32_t DynamicAabbTree::allocateNode()
+    {
+        if (m_freeList == NULL_NODE)
+        {
+            m_nodes.emplace_back();
+            m_freeList = static_cast<std::int32_t>(m_nodes.size() - 1);
+            m_nodes.back().parent = NULL_NODE;
+        }
+        const auto node{ m_freeList };
+        m_freeList = m_nodes[node].parent;
+        m_nodes[node] = {};
+        ++m_nodeCount;
+        return node;
+    }
+
+    void DynamicAabbTree::freeNode(const std::int32_t node) noexcept
+    {
+        m_nodes[node].parent = m_freeList;
+        m_nodes[node].height = -1;
+        m_freeList = node;
+        --m_nodeCount;
+    }
+
+    void DynamicAabbTree::insertLeaf(const std::int32_t leaf)
+    {
+        if (m_root == NULL_NODE)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Descend towards the sibling that minimizes the surface area heuristic
+        const auto leafBounds{ m_nodes[leaf].bounds };
+        auto sibling{ m_root };
+        while (!m_nodes[sibling].isLeaf())
+        {
+            const auto& node{ m_nodes[sibling] };
+            const auto combinedPerimeter{ Aabb::merge(node.bounds, leafBounds).getPerimeter() };
+            // Cost of pairing the leaf with this node, and the cost pushed onto every child if we descend
+            const auto cost{ 2.0f * combinedPerimeter };
+            const auto inheritedCost{ 2.0f * (combinedPerimeter - node.bounds.getPerimeter()) };
+
+            const auto descentCost{ [&](const std::int32_t child)
+            {
+                const auto& childNode{ m_nodes[child] };
+                const auto perimeter{ Aabb::merge(childNode.bounds, leafBounds).getPerimeter() };
+                return (childNode.isLeaf() ? perimeter : perimeter - childNode.bounds.getPerimeter()) + inheritedCost;
+            } };
+            const auto firstCost{ descentCost(node.firstChild) };
+            const auto secondCost{ descentCost(node.secondChild) };
+
+            if (cost < firstCost && cost < secondCost)
+            {
+                break;
+            }
+            sibling = firstCost < secondCost ? node.firstChild : node.secondChild;
+        }
+
+        const auto newParent{ allocateNode() };
+        const auto oldParent{ m_nodes[sibling].parent };
+        m_nodes[newParent].parent = oldParent;
+        m_nodes[newParent].bounds = Aabb::merge(leafBounds, m_nodes[sibling].bounds);
+        m_nodes[newParent].height = m_nodes[sibling].height + 1;
+        m_nodes[newParent].firstChild = sibling;
+        m_nodes[newParent].secondChild = leaf;
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        if (oldParent == NULL_NODE)
+        {
+            m_root = newParent;
+        }
+        else if (m_nodes[oldParent].firstChild == sibling)
+        {
+            m_nodes[oldParent].firstChild = newParent;
+        }
+        else
+        {
+            m_nodes[oldParent].secondChild = newParent;
+        }
+
+        refitAncestors(newParent);
+    }
+
+    void DynamicAabbTree::removeLeaf(const std::int32_t leaf) noexcept
+    {
+        if (leaf == m_root)
+        {
+            m_root = NULL_NODE;
+            return;
+        }
+
+        const auto parent{ m_nodes[leaf].parent };
+        const auto grandParent{ m_nodes[parent].parent };
+        const auto sibling{ m_nodes[parent].firstChild == leaf ? m_nodes[parent].secondChild
+                                                               : m_nodes[parent].firstChild };
+        freeNode(parent);
+        m_nodes[sibling].parent = grandParent;
+        m_nodes[leaf].parent = NULL_NODE;
+
+        if (grandParent == NULL_NODE)
+        {
+            m_root = sibling;
+            return;
+        }
+        if (m_nodes[grandParent].firstChild == parent)
+        {
+            m_nodes[grandParent].firstChild = sibling;
+        }
+        else
+        {
+            m_nodes[grandParent].secondChild = sibling;
+        }
+        refitAncestors(grandParent);
+    }
+
+    void DynamicAabbTree::refitAncestors(std::int32_t node) noexcept
+    {
+        while (node != NULL_NODE)
+        {
+            node = balance(node);
+            auto& current{ m_nodes[node] };
+            const auto& first{ m_nodes[current.firstChild] };
+            const auto& second{ m_nodes[current.secondChild] };
+            current.bounds = Aabb::merge(first.bounds, second.bounds);
+            current.height = 1 + std::max(first.height, second.height);
+            node = current.parent;
+        }
+    }
+
+    std::int32_t DynamicAabbTree::balance(const std::int32_t nodeA) noexcept
+    {
+        auto& a{ m_nodes[nodeA] };
+        if (a.isLeaf() || a.height < 2)
+        {
+            return nodeA;
+        }
+
+        const auto nodeB{ a.firstChild };
+        const auto nodeC{ a.secondChild };
+        auto& b{ m_nodes[nodeB] };
+        auto& c{ m_nodes[nodeC] };
+        const auto imbalance{ c.height - b.height };
+        if (imbalance >= -1 && imbalance <= 1)
+        {
+            return nodeA;
+        }
+
+        // Promote the taller child (up) into A's place. A keeps the other child and the shorter grandchild of
+        // up, while up keeps its taller child
+        const auto promoteSecond{ imbalance > 1 };
+        const auto nodeUp{ promoteSecond ? nodeC : nodeB };
+        const auto nodeStay{ promoteSecond ? nodeB : nodeC };
+        auto& up{ m_nodes[nodeUp] };
+        const auto& stay{ m_nodes[nodeStay] };
+        const auto nodeF{ up.firstChild };
+        const auto nodeG{ up.secondChild };
+        const auto fTaller{ m_nodes[nodeF].height > m_nodes[nodeG].height };
+        const auto nodeKeep{ fTaller ? nodeF : nodeG };
+        const auto nodeMove{ fTaller ? nodeG : nodeF };
+        auto& keep{ m_nodes[nodeKeep] };
+        auto& move{ m_nodes[nodeMove] };
+
+        up.firstChild = nodeA;
+        up.secondChild = nodeKeep;
+        up.parent = a.parent;
+        a.parent = nodeUp;
+        if (up.parent == NULL_NODE)
+        {
+            m_root = nodeUp;
+        }
+        else if (m_nodes[up.parent].firstChild == nodeA)
+        {
+            m_nodes[up.parent].firstChild = nodeUp;
+        }
+        else
+        {
+            m_nodes[up.parent].secondChild = nodeUp;
+        }
+
+        if (promoteSecond)
+        {
+            a.secondChild = nodeMove;
+        }
+        else
+        {
+            a.firstChild = nodeMove;
+        }
+        move.parent = nodeA;
+
+        a.bounds = Aabb::merge(stay.bounds, move.bounds);
+        a.height = 1 + std::max(stay.height, move.height);
+        up.bounds = Aabb::merge(a.bounds, keep.bounds);
+        up.height = 1 + std::max(a.height, keep.height);
+        return nodeUp;
+    }
+} // csv
@@ -0,0 +1,634 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/FastMultipole.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <print>
+#include <ranges>
+#include <stdexcept>
+
+namespace csv
+{
+    namespace
+    {
+        // Levels beyond this would need more box storage than particles could justify
+        constexpr std::size_t MAX_LEVEL{ 10 };
+
+        // Truncation error ratio of the interaction list, sqrt(2) / (4 - sqrt(2))
+        constexpr double CONVERGENCE_RATIO{ 0.5469 };
+
+        // Boxes per job in the per-level passes
+        constexpr std::uint32_t BOX_GRAIN{ 256 };
+
+        // Particles per job when locating boxes
+        constexpr std::size_t PARTICLE_GRAIN{ 16384 };
+
+        constexpr std::uint32_t getSide(const std::size_t level) noexcept
+        {
+            return 1u << level;
+        }
+
+        constexpr std::size_t getRowGrain(const std::uint32_t side) noexcept
+        {
+            return std::max(BOX_GRAIN / side, 1u);
+        }
+
+        // Runs body(row) for every row of boxes on a level of the given side. Rows write disjoint boxes, so jobs
+        // of whole rows need no synchronization
+        template<typename Body>
+        void forEachRow(JobSystem* jobSystem, const std::uint32_t side, const Body& body)
+        {
+            parallelFor(jobSystem, 0, side, getRowGrain(side), [&](const std::size_t begin, const std::size_t end)
+            {
+                for (const auto row : std::views::iota(begin, end))
+                {
+                    body(static_cast<std::uint32_t>(row));
+                }
+            });
+        }
+    }
+
+    FastMultipole::FastMultipole()
+        : FastMultipole{ Settings{} }
+    {
+    }
+
+    FastMultipole::FastMultipole(const Settings& settings)
+        : m_settings{ settings }
+    {
+        if (settings.order == 0 || settings.leafSize == 0)
+        {
+            std::println(stderr,
+                         "Fast multipole order ({}) and leaf size ({}) must be positive",
+                         settings.order,
+                         settings.leafSize);
+            throw std::runtime_error("Invalid fast multipole settings");
+        }
+
+        // Pascal's triangle, deep enough for the multipole to local conversion
+        const auto rowCount{ 2 * settings.order + 1 };
+        m_binomials.resize(rowCount);
+        m_binomials[0].assign(1, 1.0);
+        for (const auto n : std::views::iota(1uz, rowCount))
+        {
+            m_binomials[n].assign(n + 1, 1.0);
+            for (const auto k : std::views::iota(1uz, n))
+            {
+                m_binomials[n][k] = m_binomials[n - 1][k - 1] + m_binomials[n - 1][k];
+            }
+        }
+    }
+
+    double FastMultipole::operator()(const ParticleSystem& particles, const std::span<glm::vec2> accelerations)
+    {
+        if (particles.empty())
+        {
+            return 0.0;
+        }
+
+        bin(particles);
+        formMultipoles();
+        translateMultipolesUp();
+        convertMultipolesToLocals();
+        translateLocalsDown();
+        const auto potential{ evaluate(particles, accelerations) };
+
+        const auto sign{ m_settings.interaction == Interaction::Gravity ? 1.0 : -1.0 };
+        // Every pair was counted from both ends
+        return 0.5 * sign * m_settings.couplingConstant * potential;
+    }
+
+    std::size_t FastMultipole::orderForTolerance(const double tolerance) noexcept
+    {
+        if (!(tolerance < 1.0))
+        {
+            return 1;
+        }
+        const auto order{ std::ceil(std::log(std::max(tolerance, 1e-300)) / std::log(CONVERGENCE_RATIO)) };
+        return std::max(1uz, static_cast<std::size_t>(order));
+    }
+
+    FastMultipole::Error FastMultipole::measureError(const ParticleSystem& particles,
+                                                     const std::span<const glm::vec2> accelerations,
+                                                     const std::size_t sampleCount) const
+    {
+        const auto count{ particles.size() };
+        const auto samples{ std::min(sampleCount, count) };
+        if (samples == 0)
+        {
+            return { 0.0, 0.0 };
+        }
+
+        const auto positions{ particles.getPositions() };
+        const auto softeningSquared{ static_cast<double>(m_settings.softening) * m_settings.softening };
+
+        auto exactSquared{ 0.0 };
+        auto errorSquared{ 0.0 };
+        auto maxError{ 0.0 };
+        for (const auto sample : std::views::iota(0uz, samples))
+        {
+            const auto index{ sample * count / samples };
+            const glm::dvec2 position{ positions[index] };
+
+            glm::dvec2 field{ 0.0 };
+            for (const auto other : std::views::iota(0uz, count))
+            {
+                if (other == index)
+                {
+                    continue;
+                }
+                const auto separation{ position - glm::dvec2{ positions[other] } };
+                field += separation * (getStrength(particles, other)
+                                       / (glm::dot(separation, separation) + softeningSquared));
+            }
+
+            const glm::dvec2 exact{ toAcceleration(particles, index, field) };
+            const auto error{ glm::length(glm::dvec2{ accelerations[index] } - exact) };
+            exactSquared += glm::dot(exact, exact);
+            errorSquared += error * error;
+            maxError = std::max(maxError, error);
+        }
+
+        const auto exactRms{ std::sqrt(exactSquared / static_cast<double>(samples)) };
+        if (exactRms == 0.0)
+        {
+            return { 0.0, 0.0 };
+        }
+        return { std::sqrt(errorSquared / static_cast<double>(samples)) / exactRms, maxError / exactRms };
+    }
+
+    const FastMultipole::Settings& FastMultipole::getSettings() const noexcept
+    {
+        return m_settings;
+    }
+
+    void FastMultipole::setJobSystem(JobSystem* jobSystem) noexcept
+    {
+        m_jobSystem = jobSystem;
+    }
+
+    std::size_t FastMultipole::getLevelCount() const noexcept
+    {
+        return m_levelCount;
+    }
+
+    void FastMultipole::bin(const ParticleSystem& particles)
+    {
+        const auto positions{ particles.getPositions() };
+        const auto count{ positions.size() };
+
+        glm::vec2 lower{ positions[0] };
+        glm::vec2 upper{ positions[0] };
+        for (const auto& position : positions)
+        {
+            lower = glm::min(lower, position);
+            upper = glm::max(upper, position);
+        }
+        const auto extent{ static_cast<double>(std::max(upper.x - lower.x, upper.y - lower.y)) };
+        // Widened so that the upper edge still falls inside the last box
+        m_rootSize = std::max(extent * (1.0 + 1e-6), 1e-6);
+        m_origin = glm::dvec2{ lower };
+
+        // Box coordinates at the deepest possible level, packed as row and column; coarser levels drop low bits
+        const auto maxSide{ getSide(MAX_LEVEL) };
+        const auto inverseBoxSize{ static_cast<double>(maxSide) / m_rootSize };
+        m_particleBoxes.resize(count);
+        parallelFor(m_jobSystem, 0, count, PARTICLE_GRAIN, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (const auto index : std::views::iota(begin, end))
+            {
+                const auto scaled{ (glm::dvec2{ positions[index] } - m_origin) * inverseBoxSize };
+                const auto column{ std::min(static_cast<std::uint32_t>(std::max(scaled.x, 0.0)), maxSide - 1) };
+                const auto row{ std::min(static_cast<std::uint32_t>(std::max(scaled.y, 0.0)), maxSide - 1) };
+                m_particleBoxes[index] = row << 16 | column;
+            }
+        });
+
+        // Deepen until the average occupied leaf holds at most leafSize particles. Clustered scenes leave most
+        // boxes empty, so counting all of them would stop too shallow and inflate the near field
+        const auto leafCount{ static_cast<double>(count) / static_cast<double>(m_settings.leafSize) };
+        auto finestLevel{ std::clamp(static_cast<std::size_t>(std::ceil(std::log2(std::max(leafCount, 1.0)) / 2.0)),
+                                     2uz,
+                                     MAX_LEVEL) };
+        for (std::vector<std::uint8_t> occupied; finestLevel < MAX_LEVEL; ++finestLevel)
+        {
+            const auto shift{ static_cast<std::uint32_t>(MAX_LEVEL - finestLevel) };
+            occupied.assign(static_cast<std::size_t>(getSide(finestLevel)) * getSide(finestLevel), 0);
+            auto occupiedCount{ 0uz };
+            for (const auto packed : m_particleBoxes)
+            {
+                auto& flag{ occupied[((packed >> 16) >> shift << finestLevel) | ((packed & 0xffffu) >> shift)] };
+                occupiedCount += flag == 0;
+                flag = 1;
+            }
+            if (count <= m_settings.leafSize * occupiedCount)
+            {
+                break;
+            }
+        }
+        m_levelCount = finestLevel + 1;
+
+        const auto side{ getSide(finestLevel) };
+        const auto boxCount{ static_cast<std::size_t>(side) * side };
+        const auto shift{ static_cast<std::uint32_t>(MAX_LEVEL - finestLevel) };
+        m_boxStarts.assign(boxCount + 1, 0);
+        for (auto& box : m_particleBoxes)
+        {
+            box = ((box >> 16) >> shift << finestLevel) | ((box & 0xffffu) >> shift);
+            ++m_boxStarts[box + 1];
+        }
+
+        m_counts.resize(m_levelCount);
+        auto& finestCounts{ m_counts[finestLevel] };
+        finestCounts.assign(m_boxStarts.begin() + 1, m_boxStarts.end());
+        for (const auto box : std::views::iota(0uz, boxCount))
+        {
+            m_boxStarts[box + 1] += m_boxStarts[box];
+        }
+
+        m_sortedIndices.resize(count);
+        m_sortedPositions.resize(count);
+        m_sortedStrengths.resize(count);
+        {
+            std::vector<std::uint32_t> cursors(m_boxStarts.begin(), m_boxStarts.end() - 1);
+            for (const auto index : std::views::iota(0uz, count))
+            {
+                const auto slot{ cursors[m_particleBoxes[index]]++ };
+                m_sortedIndices[slot] = static_cast<std::uint32_t>(index);
+                m_sortedPositions[slot] = { positions[index].x, positions[index].y };
+                m_sortedStrengths[slot] = getStrength(particles, index);
+            }
+        }
+
+        for (const auto level : std::views::iota(0uz, finestLevel) | std::views::reverse)
+        {
+            const auto levelSide{ getSide(level) };
+            const auto& childCounts{ m_counts[level + 1] };
+            auto& levelCounts{ m_counts[level] };
+            levelCounts.assign(static_cast<std::size_t>(levelSide) * levelSide, 0);
+            for (const auto row : std::views::iota(0u, levelSide))
+            {
+                for (const auto column : std::views::iota(0u, levelSide))
+                {
+                    const auto child{ 2 * row * (2 * levelSide) + 2 * column };
+                    levelCounts[row * levelSide + column] = childCounts[child] + childCounts[child + 1]
+                                                            + childCounts[child + 2 * levelSide]
+                                                            + childCounts[child + 2 * levelSide + 1];
+                }
+            }
+        }
+
+        const auto coefficientCount{ m_settings.order + 1 };
+        m_multipoles.resize(m_levelCount);
+        m_locals.resize(m_levelCount);
+        for (const auto level : std::views::iota(0uz, m_levelCount))
+        {
+            const auto levelBoxes{ m_counts[level].size() * coefficientCount };
+            m_multipoles[level].assign(levelBoxes, Complex{});
+            m_locals[level].assign(levelBoxes, Complex{});
+        }
+    }
+
+    void FastMultipole::formMultipoles()
+    {
+        const auto order{ m_settings.order };
+        const auto finestLevel{ m_levelCount - 1 };
+        const auto side{ getSide(finestLevel) };
+        const auto& counts{ m_counts[finestLevel] };
+        auto& multipoles{ m_multipoles[finestLevel] };
+
+        forEachRow(m_jobSystem, side, [&](const std::uint32_t row)
+        {
+            for (const auto column : std::views::iota(0u, side))
+            {
+                const auto box{ row * side + column };
+                if (counts[box] == 0)
+                {
+                    continue;
+                }
+
+                const auto center{ getBoxCenter(finestLevel, column, row) };
+                const auto coefficients{ multipoles.begin() + static_cast<std::ptrdiff_t>(box * (order + 1)) };
+                for (const auto slot : std::views::iota(m_boxStarts[box], m_boxStarts[box + 1]))
+                {
+                    const auto strength{ m_sortedStrengths[slot] };
+                    const auto offset{ m_sortedPositions[slot] - center };
+                    coefficients[0] += strength;
+                    auto power{ Complex{ strength } };
+                    for (const auto k : std::views::iota(1uz, order + 1))
+                    {
+                        power *= offset;
+                        coefficients[static_cast<std::ptrdiff_t>(k)] -= power / static_cast<double>(k);
+                    }
+                }
+            }
+        });
+    }
+
+    void FastMultipole::translateMultipolesUp()
+    {
+        const auto order{ m_settings.order };
+
+        // Only levels from 2 down take part in the conversion to locals
+        for (const auto level : std::views::iota(2uz, m_levelCount - 1) | std::views::reverse)
+        {
+            const auto side{ getSide(level) };
+            const auto& childMultipoles{ m_multipoles[level + 1] };
+            const auto& childCounts{ m_counts[level + 1] };
+            auto& multipoles{ m_multipoles[level] };
+
+            forEachRow(m_jobSystem, side, [&](const std::uint32_t row)
+            {
+                std::vector<Complex> powers(order + 1);
+                for (const auto column : std::views::iota(0u, side))
+                {
+                    const auto parent{ row * side + column };
+                    if (m_counts[level][parent] == 0)
+                    {
+                        continue;
+                    }
+
+                    const auto parentCenter{ getBoxCenter(level, column, row) };
+                    const auto target{ multipoles.begin() + static_cast<std::ptrdiff_t>(parent * (order + 1)) };
+                    for (const auto childRow : { 2 * row, 2 * row + 1 })
+                    {
+                        for (const auto childColumn : { 2 * column, 2 * column + 1 })
+                        {
+                            const auto child{ childRow * (2 * side) + childColumn };
+                            if (childCounts[child] == 0)
+                            {
+                                continue;
+                            }
+
+                            const auto source{ childMultipoles.begin()
+                                               + static_cast<std::ptrdiff_t>(child * (order + 1)) };
+                            const auto shift{ getBoxCenter(level + 1, childColumn, childRow) - parentCenter };
+                            powers[0] = 1.0;
+                            for (const auto k : std::views::iota(1uz, order + 1))
+                            {
+                                powers[k] = powers[k - 1] * shift;
+                            }
+
+                            target[0] += source[0];
+                            for (const auto l : std::views::iota(1uz, order + 1))
+                            {
+                                auto coefficient{ -source[0] * powers[l] / static_cast<double>(l) };
+                                for (const auto k : std::views::iota(1uz, l + 1))
+                                {
+                                    coefficient += source[static_cast<std::ptrdiff_t>(k)] * powers[l - k]
+                                                   * m_binomials[l - 1][k - 1];
+                                }
+                                target[static_cast<std::ptrdiff_t>(l)] += coefficient;
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    void FastMultipole::convertMultipolesToLocals()
+    {
+        const auto order{ m_settings.order };
+
+        for (const auto level : std::views::iota(2uz, m_levelCount))
+        {
+            const auto side{ getSide(level) };
+            const auto& counts{ m_counts[level] };
+            const auto& multipoles{ m_multipoles[level] };
+            auto& locals{ m_locals[level] };
+
+            forEachRow(m_jobSystem, side, [&](const std::uint32_t row)
+            {
+                std::vector<Complex> terms(order + 1);
+                for (const auto column : std::views::iota(0u, side))
+                {
+                    const auto box{ row * side + column };
+                    if (counts[box] == 0)
+                    {
+                        continue;
+                    }
+
+                    const auto center{ getBoxCenter(level, column, row) };
+                    const auto target{ locals.begin() + static_cast<std::ptrdiff_t>(box * (order + 1)) };
+
+                    // Children of the parent's neighbours that are not neighbours themselves
+                    const auto firstRow{ 2 * (std::max(row / 2, 1u) - 1) };
+                    const auto lastRow{ std::min(2 * (row / 2 + 1) + 1, side - 1) };
+                    const auto firstColumn{ 2 * (std::max(column / 2, 1u) - 1) };
+                    const auto lastColumn{ std::min(2 * (column / 2 + 1) + 1, side - 1) };
+                    for (const auto sourceRow : std::views::iota(firstRow, lastRow + 1))
+                    {
+                        for (const auto sourceColumn : std::views::iota(firstColumn, lastColumn + 1))
+                        {
+                            const auto sourceBox{ sourceRow * side + sourceColumn };
+                            const auto adjacent{ sourceRow + 1 >= row && sourceRow <= row + 1
+                                                 && sourceColumn + 1 >= column && sourceColumn <= column + 1 };
+                            if (adjacent || counts[sourceBox] == 0)
+                            {
+                                continue;
+                            }
+
+                            const auto source{ multipoles.begin()
+                                               + static_cast<std::ptrdiff_t>(sourceBox * (order + 1)) };
+                            const auto separation{ getBoxCenter(level, sourceColumn, sourceRow) - center };
+                            const auto inverse{ 1.0 / separation };
+
+                            // terms[k] = a_k (-1 / z0)^k
+                            auto power{ Complex{ 1.0 } };
+                            auto constant{ source[0] * std::log(-separation) };
+                            for (const auto k : std::views::iota(1uz, order + 1))
+                            {
+                                power *= -inverse;
+                                terms[k] = source[static_cast<std::ptrdiff_t>(k)] * power;
+                                constant += terms[k];
+                            }
+                            target[0] += constant;
+
+                            auto inversePower{ Complex{ 1.0 } };
+                            for (const auto l : std::views::iota(1uz, order + 1))
+                            {
+                                inversePower *= inverse;
+                                auto coefficient{ -source[0] / static_cast<double>(l) };
+                                for (const auto k : std::views::iota(1uz, order + 1))
+                                {
+                                    coefficient += terms[k] * m_binomials[l + k - 1][k - 1];
+                                }
+                                target[static_cast<std::ptrdiff_t>(l)] += coefficient * inversePower;
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    void FastMultipole::translateLocalsDown()
+    {
+        const auto order{ m_settings.order };
+
+        for (const auto level : std::views::iota(2uz, m_levelCount - 1))
+        {
+            const auto side{ getSide(level) };
+            const auto& locals{ m_locals[level] };
+            const auto& childCounts{ m_counts[level + 1] };
+            auto& childLocals{ m_locals[level + 1] };
+
+            forEachRow(m_jobSystem, side, [&](const std::uint32_t row)
+            {
+                std::vector<Complex> shifted(order + 1);
+                for (const auto column : std::views::iota(0u, side))
+                {
+                    const auto parent{ row * side + column };
+                    if (m_counts[level][parent] == 0)
+                    {
+                        continue;
+                    }
+
+                    const auto parentCenter{ getBoxCenter(level, column, row) };
+                    const auto source{ locals.begin() + static_cast<std::ptrdiff_t>(parent * (order + 1)) };
+                    for (const auto childRow : { 2 * row, 2 * row + 1 })
+                    {
+                        for (const auto childColumn : { 2 * column, 2 * column + 1 })
+                        {
+                            const auto child{ childRow * (2 * side) + childColumn };
+                            if (childCounts[child] == 0)
+                            {
+                                continue;
+                            }
+
+                            // Taylor shift of the polynomial to the child's center
+                            const auto shift{ getBoxCenter(level + 1, childColumn, childRow) - parentCenter };
+                            std::copy_n(source, order + 1, shifted.begin());
+                            for (const auto j : std::views::iota(0uz, order))
+                            {
+                                for (const auto k : std::views::iota(j, order) | std::views::reverse)
+                                {
+                                    shifted[k] += shift * shifted[k + 1];
+                                }
+                            }
+
+                            const auto target{ childLocals.begin() + static_cast<std::ptrdiff_t>(child * (order + 1)) };
+                            for (const auto k : std::views::iota(0uz, order + 1))
+                            {
+                                target[static_cast<std::ptrdiff_t>(k)] += shifted[k];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    double FastMultipole::evaluate(const ParticleSystem& particles, const std::span<glm::vec2> accelerations) const
+    {
+        const auto order{ m_settings.order };
+        const auto finestLevel{ m_levelCount - 1 };
+        const auto side{ getSide(finestLevel) };
+        const auto& locals{ m_locals[finestLevel] };
+        const auto softeningSquared{ static_cast<double>(m_settings.softening) * m_settings.softening };
+
+        const auto evaluateRows{ [&](const std::size_t beginRow, const std::size_t endRow)
+        {
+            auto potentialSum{ 0.0 };
+            const auto rows{ std::views::iota(static_cast<std::uint32_t>(beginRow), static_cast<std::uint32_t>(endRow)) };
+            for (const auto row : rows)
+            {
+                const auto firstRow{ row == 0 ? 0 : row - 1 };
+                const auto lastRow{ std::min(row + 1, side - 1) };
+                for (const auto column : std::views::iota(0u, side))
+                {
+                    const auto box{ row * side + column };
+                    if (m_boxStarts[box] == m_boxStarts[box + 1])
+                    {
+                        continue;
+                    }
+
+                    const auto center{ getBoxCenter(finestLevel, column, row) };
+                    const auto coefficients{ locals.begin() + static_cast<std::ptrdiff_t>(box * (order + 1)) };
+                    const auto firstColumn{ column == 0 ? 0 : column - 1 };
+                    const auto lastColumn{ std::min(column + 1, side - 1) };
+
+                    for (const auto slot : std::views::iota(m_boxStarts[box], m_boxStarts[box + 1]))
+                    {
+                        const auto position{ m_sortedPositions[slot] };
+
+                        // Far field: Horner evaluation of the local expansion and its derivative
+                        const auto offset{ position - center };
+                        auto potential{ coefficients[static_cast<std::ptrdiff_t>(order)] };
+                        auto derivative{ Complex{} };
+                        for (const auto k : std::views::iota(0uz, order) | std::views::reverse)
+                        {
+                            derivative = derivative * offset + potential;
+                            potential = potential * offset + coefficients[static_cast<std::ptrdiff_t>(k)];
+                        }
+                        // The gradient of the real potential is the conjugate of the complex derivative
+                        auto fieldX{ derivative.real() };
+                        auto fieldY{ -derivative.imag() };
+                        auto realPotential{ potential.real() };
+
+                        // Near field: each row of neighbouring boxes is a contiguous range of the sorted order
+                        for (const auto neighbourRow : std::views::iota(firstRow, lastRow + 1))
+                        {
+                            const auto begin{ m_boxStarts[neighbourRow * side + firstColumn] };
+                            const auto end{ m_boxStarts[neighbourRow * side + lastColumn + 1] };
+                            for (const auto other : std::views::iota(begin, end))
+                            {
+                                if (other == slot)
+                                {
+                                    continue;
+                                }
+                                const auto separation{ position - m_sortedPositions[other] };
+                                const auto distanceSquared{ std::norm(separation) + softeningSquared };
+                                const auto strength{ m_sortedStrengths[other] };
+                                const auto weight{ strength / distanceSquared };
+                                fieldX += weight * separation.real();
+                                fieldY += weight * separation.imag();
+                                realPotential += 0.5 * strength * std::log(distanceSquared);
+                            }
+                        }
+
+                        const auto index{ m_sortedIndices[slot] };
+                        accelerations[index] = toAcceleration(particles, index, { fieldX, fieldY });
+                        potentialSum += m_sortedStrengths[slot] * realPotential;
+                    }
+                }
+            }
+            return potentialSum;
+        } };
+        return parallelReduce(m_jobSystem, 0uz, side, getRowGrain(side), 0.0, evaluateRows, std::plus{});
+    }
+
+    FastMultipole::Complex FastMultipole::getBoxCenter(const std::size_t level,
+                                                       const std::uint32_t column,
+                                                       const std::uint32_t row) const noexcept
+    {
+        const auto boxSize{ m_rootSize / static_cast<double>(getSide(level)) };
+        return { m_origin.x + (column + 0.5) * boxSize, m_origin.y + (row + 0.5) * boxSize };
+    }
+
+    double FastMultipole::getStrength(const ParticleSystem& particles, const std::size_t index) const noexcept
+    {
+        return m_settings.interaction == Interaction::Gravity
+                   ? static_cast<double>(particles.getMasses()[index])
+                   : static_cast<double>(particles.getCharges()[index]);
+    }
+
+    glm::vec2 FastMultipole::toAcceleration(const ParticleSystem& particles,
+                                            const std::size_t index,
+                                            const glm::dvec2& field) const noexcept
+    {
+        // Gravity pulls down the potential gradient; like charges push up it
+        const auto coupling{ static_cast<double>(m_settings.couplingConstant) };
+        if (m_settings.interaction == Interaction::Gravity)
+        {
+            return glm::vec2{ -coupling * field };
+        }
+        const auto chargeToMass{ static_cast<double>(particles.getCharges()[index]) / particles.getMasses()[index] };
+        return glm::vec2{ coupling * chargeToMass * field };
+    }
+} // csv
@@ -0,0 +1,43 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/FixedTimestep.h"
+
+#include <algorithm>
+
+namespace csv
+{
+    FixedTimestep::FixedTimestep(const double stepSeconds, const std::size_t maxStepsPerFrame) noexcept
+        : m_stepSeconds{ stepSeconds }
+        , m_maxStepsPerFrame{ std::max(maxStepsPerFrame, 1uz) }
+    {
+    }
+
+    std::size_t FixedTimestep::advance(const double frameSeconds) noexcept
+    {
+        m_accumulator += std::max(frameSeconds, 0.0);
+
+        const auto pendingSteps{ static_cast<std::size_t>(m_accumulator / m_stepSeconds) };
+        const auto steps{ std::min(pendingSteps, m_maxStepsPerFrame) };
+        m_accumulator -= static_cast<double>(pendingSteps) * m_stepSeconds;
+        m_droppedSteps += pendingSteps - steps;
+
+        return steps;
+    }
+
+    float FixedTimestep::getInterpolation() const noexcept
+    {
+        return static_cast<float>(std::clamp(m_accumulator / m_stepSeconds, 0.0, 1.0));
+    }
+
+    double FixedTimestep::getStepSeconds() const noexcept
+    {
+        return m_stepSeconds;
+    }
+
+    std::uint64_t FixedTimestep::getDroppedSteps() const noexcept
+    {
+        return m_droppedSteps;
+    }
+} // csv
@@ -0,0 +1,174 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/GlState.h"
+
+#include <array>
+#include <optional>
+#include <utility>
+
+namespace csv
+{
+    namespace
+    {
+        constexpr std::array<GLenum, 9> BUFFER_TARGETS{
+            GL_ARRAY_BUFFER,
+            GL_ELEMENT_ARRAY_BUFFER,
+            GL_UNIFORM_BUFFER,
+            GL_COPY_READ_BUFFER,
+            GL_COPY_WRITE_BUFFER,
+            GL_PIXEL_PACK_BUFFER,
+            GL_PIXEL_UNPACK_BUFFER,
+            GL_TEXTURE_BUFFER,
+            GL_TRANSFORM_FEEDBACK_BUFFER
+        };
+
+        // An empty optional means the value is unknown and the next change must be issued
+        struct State
+        {
+            std::optional<GLuint> program{};
+            std::optional<GLuint> vertexArray{};
+            std::array<std::optional<GLuint>, BUFFER_TARGETS.size()> buffers{};
+            std::optional<bool> blending{};
+            std::optional<std::pair<GLenum, GLenum>> blendFunction{};
+        };
+
+        State state{};
+        GlState::Counters frameCounters{};
+
+        std::optional<GLuint>* findBufferBinding(const GLenum target)
+        {
+            for (std::size_t index{}; index < BUFFER_TARGETS.size(); ++index)
+            {
+                if (BUFFER_TARGETS[index] == target)
+                {
+                    return &state.buffers[index];
+                }
+            }
+            return nullptr;
+        }
+
+        template<typename T>
+        bool update(std::optional<T>& cached, const T& value)
+        {
+            if (cached == value)
+            {
+                ++frameCounters.skipped;
+                return false;
+            }
+            cached = value;
+            ++frameCounters.issued;
+            return true;
+        }
+
+        template<typename T>
+        void forget(std::optional<T>& cached, const T& value)
+        {
+            if (cached == value)
+            {
+                cached.reset();
+            }
+        }
+    }
+
+    void GlState::useProgram(const GLuint program)
+    {
+        if (update(state.program, program))
+        {
+            glUseProgram(program);
+        }
+    }
+
+    void GlState::bindVertexArray(const GLuint vertexArray)
+    {
+        if (update(state.vertexArray, vertexArray))
+        {
+            glBindVertexArray(vertexArray);
+            // The element array binding is part of the vertex array object
+            findBufferBinding(GL_ELEMENT_ARRAY_BUFFER)->reset();
+        }
+    }
+
+    void GlState::bindBuffer(const GLenum target, const GLuint buffer)
+    {
+        auto* const binding{ findBufferBinding(target) };
+        if (binding == nullptr)
+        {
+            ++frameCounters.issued;
+            glBindBuffer(target, buffer);
+            return;
+        }
+        if (update(*binding, buffer))
+        {
+            glBindBuffer(target, buffer);
+        }
+    }
+
+    void GlState::bindBufferBase(const GLenum target, const GLuint index, const GLuint buffer)
+    {
+        glBindBufferBase(target, index, buffer);
+        ++frameCounters.issued;
+        if (auto* const binding{ findBufferBinding(target) }; binding != nullptr)
+        {
+            *binding = buffer;
+        }
+    }
+
+    void GlState::setBlending(const bool enabled)
+    {
+        if (update(state.blending, enabled))
+        {
+            enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+        }
+    }
+
+    void GlState::setBlendFunction(const GLenum sourceFactor, const GLenum destinationFactor)
+    {
+        if (update(state.blendFunction, std::pair{ sourceFactor, destinationFactor }))
+        {
+            glBlendFunc(sourceFactor, destinationFactor);
+        }
+    }
+
+    void GlState::onProgramDeleted(const GLuint program)
+    {
+        forget(state.program, program);
+    }
+
+    void GlState::onVertexArrayDeleted(const GLuint vertexArray)
+    {
+        if (state.vertexArray == vertexArray)
+        {
+            // Deleting the bound vertex array reverts the binding to zero
+            state.vertexArray = 0;
+            findBufferBinding(GL_ELEMENT_ARRAY_BUFFER)->reset();
+        }
+    }
+
+    void GlState::onBufferDeleted(const GLuint buffer)
+    {
+        for (auto& binding : state.buffers)
+        {
+            if (binding == buffer)
+            {
+                binding = 0;
+            }
+        }
+    }
+
+    void GlState::invalidate()
+    {
+        state = {};
+    }
+
+    GlState::Counters GlState::beginFrame()
+    {
+        return std::exchange(frameCounters, {});
+    }
+
+    const GlState::Counters& GlState::getFrameCounters()
+    {
+        return frameCounters;
+    }
+} // csv
@@ -0,0 +1,188 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/GpuRingBuffer.h"
+
+#include <algorithm>
+#include <print>
+#include <ranges>
+#include <stdexcept>
+#include "utilities/GlState.h"
+
+namespace csv
+{
+    namespace
+    {
+        constexpr std::size_t alignUp(const std::size_t size, const std::size_t alignment)
+        {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        constexpr GLbitfield PERSISTENT_FLAGS{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+    }
+
+    GpuRingBuffer::GpuRingBuffer(const GLenum target, const std::size_t regionSize, const std::size_t regionCount)
+        : m_target{ target }
+        , m_regionSize{ alignUp(std::max(regionSize, REGION_ALIGNMENT), REGION_ALIGNMENT) }
+        , m_regionCount{ std::max(regionCount, 1uz) }
+        , m_persistent{ GLAD_GL_ARB_buffer_storage != 0 }
+        , m_fences(m_regionCount, nullptr)
+    {
+        allocate();
+    }
+
+    GpuRingBuffer::~GpuRingBuffer()
+    {
+        release();
+    }
+
+    void GpuRingBuffer::reserve(const std::size_t regionSize)
+    {
+        if (regionSize <= m_regionSize)
+        {
+            return;
+        }
+        for (const auto index : std::views::iota(0uz, m_regionCount))
+        {
+            waitForRegion(index);
+        }
+        release();
+        m_regionSize = alignUp(std::max(regionSize, m_regionSize * 2), REGION_ALIGNMENT);
+        m_regionIndex = 0;
+        allocate();
+    }
+
+    std::span<std::byte> GpuRingBuffer::beginWrite()
+    {
+        if (!m_persistent)
+        {
+            return { m_staging.data(), m_regionSize };
+        }
+        waitForRegion(m_regionIndex);
+        return { m_mapping + getRegionOffset(), m_regionSize };
+    }
+
+    GLintptr GpuRingBuffer::endWrite(const std::size_t writtenBytes)
+    {
+        if (writtenBytes > m_regionSize)
+        {
+            std::println(stderr, "Wrote {} bytes into a {} byte ring buffer region", writtenBytes, m_regionSize);
+            throw std::runtime_error("Ring buffer region overflow");
+        }
+        if (!m_persistent)
+        {
+            GlState::bindBuffer(m_target, m_bufferId);
+            if (m_regionIndex == 0)
+            {
+                // Orphan once per lap so the regions still queued for the GPU keep their old storage
+                glBufferData(m_target,
+                             static_cast<GLsizeiptr>(m_regionSize * m_regionCount),
+                             nullptr,
+                             GL_STREAM_DRAW);
+            }
+            glBufferSubData(m_target,
+                            getRegionOffset(),
+                            static_cast<GLsizeiptr>(writtenBytes),
+                            m_staging.data());
+        }
+        return getRegionOffset();
+    }
+
+    void GpuRingBuffer::fence()
+    {
+        if (m_persistent)
+        {
+            glDeleteSync(m_fences[m_regionIndex]);
+            m_fences[m_regionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        m_regionIndex = (m_regionIndex + 1) % m_regionCount;
+    }
+
+    GLuint GpuRingBuffer::getId() const noexcept
+    {
+        return m_bufferId;
+    }
+
+    std::size_t GpuRingBuffer::getRegionSize() const noexcept
+    {
+        return m_regionSize;
+    }
+
+    bool GpuRingBuffer::isPersistent() const noexcept
+    {
+        return m_persistent;
+    }
+
+    void GpuRingBuffer::allocate()
+    {
+        const auto totalSize{ static_cast<GLsizeiptr>(m_regionSize * m_regionCount) };
+
+        glGenBuffers(1, &m_bufferId);
+        GlState::bindBuffer(m_target, m_bufferId);
+        if (m_persistent)
+        {
+            glBufferStorage(m_target, totalSize, nullptr, PERSISTENT_FLAGS);
+            m_mapping = static_cast<std::byte*>(glMapBufferRange(m_target, 0, totalSize, PERSISTENT_FLAGS));
+            if (m_mapping == nullptr)
+            {
+                std::println(stderr, "Failed to persistently map a {} byte ring buffer", totalSize);
+                throw std::runtime_error("Failed to map ring buffer");
+            }
+        }
+        else
+        {
+            glBufferData(m_target, totalSize, nullptr, GL_STREAM_DRAW);
+            m_staging.resize(m_regionSize);
+        }
+        GlState::bindBuffer(m_target, 0);
+    }
+
+    void GpuRingBuffer::release()
+    {
+        for (auto& fence : m_fences)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        if (m_mapping != nullptr)
+        {
+            GlState::bindBuffer(m_target, m_bufferId);
+            glUnmapBuffer(m_target);
+            GlState::bindBuffer(m_target, 0);
+            m_mapping = nullptr;
+        }
+        GlState::onBufferDeleted(m_bufferId);
+        glDeleteBuffers(1, &m_bufferId);
+        m_bufferId = 0;
+    }
+
+    void GpuRingBuffer::waitForRegion(const std::size_t regionIndex)
+    {
+        auto& fence{ m_fences[regionIndex] };
+        if (fence == nullptr)
+        {
+            return;
+        }
+        constexpr GLuint64 timeoutNanoseconds{ 1'000'000'000 };
+        while (true)
+        {
+            const auto status{ glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds) };
+            if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+            if (status == GL_WAIT_FAILED)
+            {
+                throw std::runtime_error("Waiting for ring buffer fence failed");
+            }
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    GLintptr GpuRingBuffer::getRegionOffset() const noexcept
+    {
+        return static_cast<GLintptr>(m_regionIndex * m_regionSize);
+    }
+} // csv
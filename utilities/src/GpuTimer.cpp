@@ -0,0 +1,114 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/GpuTimer.h"
+
+#include <limits>
+#include <print>
+#include <ranges>
+
+namespace csv
+{
+    namespace
+    {
+        constexpr auto NO_SCOPE{ std::numeric_limits<std::size_t>::max() };
+    }
+
+    GpuTimer::Scope::Scope(GpuTimer& timer, const std::string_view name)
+        : m_timer{ timer }
+        , m_index{ timer.beginScope(name) }
+    {
+    }
+
+    GpuTimer::Scope::~Scope()
+    {
+        m_timer.endScope(m_index);
+    }
+
+    GpuTimer::GpuTimer(const std::size_t maxScopesPerFrame)
+        : m_maxScopesPerFrame{ maxScopesPerFrame }
+    {
+        for (auto& frame : m_frames)
+        {
+            // A begin and an end timestamp per scope
+            frame.queries.resize(2 * m_maxScopesPerFrame);
+            glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+            frame.scopes.reserve(m_maxScopesPerFrame);
+        }
+        m_results.reserve(m_maxScopesPerFrame);
+    }
+
+    GpuTimer::~GpuTimer()
+    {
+        for (auto& frame : m_frames)
+        {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+    }
+
+    void GpuTimer::beginFrame()
+    {
+        m_frameIndex = (m_frameIndex + 1) % LATENCY;
+        auto& frame{ m_frames[m_frameIndex] };
+        collect(frame);
+        frame.scopes.clear();
+    }
+
+    std::span<const GpuTimer::PassTiming> GpuTimer::getResults() const noexcept
+    {
+        return m_results;
+    }
+
+    std::size_t GpuTimer::beginScope(const std::string_view name)
+    {
+        auto& frame{ m_frames[m_frameIndex] };
+        if (frame.scopes.size() == m_maxScopesPerFrame)
+        {
+            return NO_SCOPE;
+        }
+        const auto index{ frame.scopes.size() };
+        glQueryCounter(frame.queries[2 * index], GL_TIMESTAMP);
+        frame.scopes.push_back({ name, Clock::now(), {} });
+        return index;
+    }
+
+    void GpuTimer::endScope(const std::size_t index)
+    {
+        if (index == NO_SCOPE)
+        {
+            return;
+        }
+        auto& frame{ m_frames[m_frameIndex] };
+        glQueryCounter(frame.queries[2 * index + 1], GL_TIMESTAMP);
+        frame.scopes[index].cpuEnd = Clock::now();
+    }
+
+    void GpuTimer::collect(Frame& frame)
+    {
+        if (frame.scopes.empty())
+        {
+            return;
+        }
+
+        // Timestamps complete in order, so the last end query tells whether the whole frame is available
+        GLint available{};
+        glGetQueryObjectiv(frame.queries[2 * frame.scopes.size() - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+            return;
+        }
+
+        m_results.clear();
+        for (const auto index : std::views::iota(0uz, frame.scopes.size()))
+        {
+            const auto& scope{ frame.scopes[index] };
+            GLuint64 begin{};
+            GLuint64 end{};
+            glGetQueryObjectui64v(frame.queries[2 * index], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(frame.queries[2 * index + 1], GL_QUERY_RESULT, &end);
+            const std::chrono::duration<double, std::milli> cpuTime{ scope.cpuEnd - scope.cpuBegin };
+            m_results.push_back({ scope.name, static_cast<double>(end - begin) * 1e-6, cpuTime.count() });
+        }
+    }
+} // csv
@@ -0,0 +1,340 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/JobSystem.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace csv
+{
+    namespace
+    {
+        // Failed searches for work before an idle worker goes to sleep
+        constexpr std::uint32_t SPIN_ROUNDS{ 64 };
+
+        std::atomic<std::uint64_t> nextSystemId{ 1 };
+
+        // Job systems whose queues a thread remembers at once
+        constexpr std::size_t CACHED_SYSTEMS{ 4 };
+
+        // Queue of the current thread in the job system with the given id. An external slot is held through a flag
+        // that shares ownership of the system's slot table, so it is released when the entry is evicted or the
+        // thread exits, even if the job system is already gone
+        struct ThreadQueue
+        {
+            std::uint64_t systemId{};
+            std::size_t queueIndex{};
+            std::shared_ptr<std::atomic<bool>> externalSlot{};
+            // Nonzero while the thread owns the queue in a run() or a worker loop; such an entry is never evicted
+            std::size_t activeUses{};
+
+            ThreadQueue() = default;
+
+            ThreadQueue(const ThreadQueue& other) = delete;
+            ThreadQueue(ThreadQueue&& other) noexcept = delete;
+            ThreadQueue& operator=(const ThreadQueue& other) = delete;
+            ThreadQueue& operator=(ThreadQueue&& other) noexcept = delete;
+
+            ~ThreadQueue()
+            {
+                release();
+            }
+
+            void release() noexcept
+            {
+                if (externalSlot)
+                {
+                    externalSlot->store(false, std::memory_order_release);
+                    externalSlot.reset();
+                }
+                systemId = 0;
+            }
+        };
+
+        thread_local std::array<ThreadQueue, CACHED_SYSTEMS> threadQueues{};
+        thread_local std::size_t nextEviction{};
+
+        // Keeps the calling thread's queue entry from being evicted while it owns that queue
+        class ActiveUse
+        {
+        public:
+            explicit ActiveUse(ThreadQueue& entry) noexcept
+                : m_entry{ entry }
+            {
+                ++m_entry.activeUses;
+            }
+
+            ActiveUse(const ActiveUse& other) = delete;
+            ActiveUse(ActiveUse&& other) noexcept = delete;
+            ActiveUse& operator=(const ActiveUse& other) = delete;
+            ActiveUse& operator=(ActiveUse&& other) noexcept = delete;
+
+            ~ActiveUse()
+            {
+                --m_entry.activeUses;
+            }
+
+        private:
+            ThreadQueue& m_entry;
+        };
+
+        ThreadQueue* findThreadQueue(const std::uint64_t systemId) noexcept
+        {
+            const auto entry{ std::ranges::find(threadQueues, systemId, &ThreadQueue::systemId) };
+            return entry == threadQueues.end() ? nullptr : &*entry;
+        }
+
+        // An unused entry, or else the next one not in active use, released; null if every entry is in use
+        ThreadQueue* evictThreadQueue() noexcept
+        {
+            if (auto* entry{ findThreadQueue(0) })
+            {
+                return entry;
+            }
+            for ([[maybe_unused]] const auto attempt : std::views::iota(0uz, CACHED_SYSTEMS))
+            {
+                auto& entry{ threadQueues[nextEviction++ % CACHED_SYSTEMS] };
+                if (entry.activeUses == 0)
+                {
+                    entry.release();
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    JobSystem::JobSystem(const std::size_t workerCount)
+        : m_id{ nextSystemId.fetch_add(1, std::memory_order_relaxed) }
+        , m_workerCount{ workerCount }
+        , m_externalSlots{ std::make_shared<ExternalSlots>() }
+    {
+        m_queues.reserve(workerCount + MAX_EXTERNAL_THREADS);
+        for ([[maybe_unused]] const auto index : std::views::iota(0uz, workerCount + MAX_EXTERNAL_THREADS))
+        {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+
+        m_workers.reserve(workerCount);
+        for (const auto index : std::views::iota(0uz, workerCount))
+        {
+            m_workers.emplace_back([this, index] { workerLoop(index); });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        m_running.store(false, std::memory_order_release);
+        wake();
+        m_workers.clear();
+    }
+
+    void JobSystem::run(const std::size_t count, void (* const function)(const void*, std::size_t), const void* context)
+    {
+        const auto queueIndex{ count > 1 && m_workerCount > 0 ? getQueueIndex() : std::nullopt };
+        if (!queueIndex)
+        {
+            for (const auto index : std::views::iota(0uz, count))
+            {
+                function(context, index);
+            }
+            return;
+        }
+
+        // The queue stays this thread's until every job is done, even if the jobs use other job systems
+        const ActiveUse activeUse{ *findThreadQueue(m_id) };
+        auto& queue{ *m_queues[*queueIndex] };
+        std::atomic<std::size_t> pending{ count };
+        std::vector<Job> jobs(count);
+
+        for (const auto index : std::views::iota(0uz, count))
+        {
+            jobs[index] = { function, context, index, &pending };
+            while (!queue.push(&jobs[index]))
+            {
+                if (auto* job{ popOwnJob(*queueIndex, &pending) })
+                {
+                    execute(*job);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            // Wake the workers as soon as there is something to take; the rest is queued while they spin up
+            if (index == 0)
+            {
+                wake();
+            }
+        }
+
+        // Only this batch's jobs are run while waiting: the rest of the queue, and every other queue, belongs to work
+        // this call is not waiting for, such as another thread's loop or a task that must not block this one. Jobs
+        // stolen from the batch are being run by their thieves and only need waiting for
+        while (pending.load(std::memory_order_acquire) != 0)
+        {
+            if (auto* job{ popOwnJob(*queueIndex, &pending) })
+            {
+                execute(*job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool JobSystem::trySubmit(Job& job)
+    {
+        const auto queueIndex{ m_workerCount > 0 ? getQueueIndex() : std::nullopt };
+        if (!queueIndex || !m_queues[*queueIndex]->push(&job))
+        {
+            return false;
+        }
+        wake();
+        return true;
+    }
+
+    bool JobSystem::runQueuedJob()
+    {
+        const auto queueIndex{ getQueueIndex() };
+        if (!queueIndex)
+        {
+            return false;
+        }
+        auto* job{ popOwnJob(*queueIndex, nullptr) };
+        if (job == nullptr)
+        {
+            return false;
+        }
+        execute(*job);
+        return true;
+    }
+
+    std::size_t JobSystem::getWorkerCount() const noexcept
+    {
+        return m_workerCount;
+    }
+
+    std::size_t JobSystem::getDefaultWorkerCount() noexcept
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    }
+
+    void JobSystem::workerLoop(const std::size_t queueIndex)
+    {
+        // A fresh thread always has a free entry; the worker's own is held for the thread's lifetime
+        auto& entry{ *evictThreadQueue() };
+        entry.systemId = m_id;
+        entry.queueIndex = queueIndex;
+        const ActiveUse activeUse{ entry };
+        auto nextVictim{ queueIndex };
+        auto idleRounds{ 0u };
+
+        while (m_running.load(std::memory_order_acquire))
+        {
+            // Read before searching, so work published after a failed search changes it and cuts the wait short
+            const auto epoch{ m_epoch.load(std::memory_order_acquire) };
+            if (auto* job{ findJob(queueIndex, nextVictim) })
+            {
+                execute(*job);
+                idleRounds = 0;
+                continue;
+            }
+
+            if (++idleRounds < SPIN_ROUNDS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            m_epoch.wait(epoch, std::memory_order_acquire);
+            idleRounds = 0;
+        }
+    }
+
+    std::optional<std::size_t> JobSystem::getQueueIndex()
+    {
+        if (const auto* entry{ findThreadQueue(m_id) })
+        {
+            return entry->queueIndex;
+        }
+
+        auto* entry{ evictThreadQueue() };
+        if (entry == nullptr)
+        {
+            return std::nullopt;
+        }
+        for (const auto slot : std::views::iota(0uz, MAX_EXTERNAL_THREADS))
+        {
+            auto& claimed{ (*m_externalSlots)[slot] };
+            auto expected{ false };
+            if (claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                entry->systemId = m_id;
+                entry->queueIndex = m_workerCount + slot;
+                entry->externalSlot = std::shared_ptr<std::atomic<bool>>{ m_externalSlots, &claimed };
+                return entry->queueIndex;
+            }
+        }
+        return std::nullopt;
+    }
+
+    JobSystem::Job* JobSystem::findJob(const std::size_t queueIndex, std::size_t& nextVictim) const noexcept
+    {
+        if (auto* job{ m_queues[queueIndex]->pop() })
+        {
+            return job;
+        }
+
+        // Round robin over the other queues, resuming after the last one that had work
+        const auto queueCount{ m_queues.size() };
+        for ([[maybe_unused]] const auto attempt : std::views::iota(0uz, queueCount))
+        {
+            nextVictim = (nextVictim + 1) % queueCount;
+            if (nextVictim == queueIndex)
+            {
+                continue;
+            }
+            if (auto* job{ m_queues[nextVictim]->steal() })
+            {
+                // Stay on this victim, it probably has more
+                nextVictim = (nextVictim + queueCount - 1) % queueCount;
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    JobSystem::Job* JobSystem::popOwnJob(const std::size_t queueIndex, const std::atomic<std::size_t>* batch) noexcept
+    {
+        auto& queue{ *m_queues[queueIndex] };
+        auto* job{ queue.pop() };
+        if (job == nullptr || batch == nullptr || job->pending == batch)
+        {
+            return job;
+        }
+        // The batch was pushed last and nested batches are drained before their run() returns, so a foreign job on
+        // top means none of the batch is left here. It goes back where it was, which cannot fail after the pop
+        queue.push(job);
+        return nullptr;
+    }
+
+    void JobSystem::wake() noexcept
+    {
+        m_epoch.fetch_add(1, std::memory_order_release);
+        m_epoch.notify_all();
+    }
+
+    void JobSystem::execute(const Job& job) noexcept
+    {
+        // Read first: a submitted job may be queued again, or freed, as soon as its function returns
+        auto* pending{ job.pending };
+        job.function(job.context, job.index);
+        if (pending != nullptr)
+        {
+            pending->fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+} // csv
@@ -0,0 +1,156 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/ParticleSystem.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace csv
+{
+    // Render uploads copy columns verbatim, so they must match the tightly packed vertex attribute formats
+    static_assert(sizeof(glm::vec2) == 2 * sizeof(float));
+    static_assert(sizeof(glm::vec4) == 4 * sizeof(float));
+
+    ParticleSystem::ParticleSystem(const std::size_t capacity)
+    {
+        reserve(capacity);
+    }
+
+    void ParticleSystem::reserve(const std::size_t capacity)
+    {
+        forEachColumn([capacity](auto& column) { column.reserve(capacity); });
+    }
+
+    std::size_t ParticleSystem::add(const Particle& particle)
+    {
+        if (size() == capacity())
+        {
+            reserve(std::max(capacity() * 2, 64uz));
+        }
+        m_positions.push_back(particle.position);
+        m_previousPositions.push_back(particle.position);
+        m_velocities.push_back(particle.velocity);
+        m_accelerations.emplace_back();
+        m_masses.push_back(particle.mass);
+        m_radii.push_back(particle.radius);
+        m_charges.push_back(particle.charge);
+        m_colors.push_back(particle.color);
+        return size() - 1;
+    }
+
+    void ParticleSystem::remove(const std::size_t index) noexcept
+    {
+        forEachColumn([index](auto& column)
+        {
+            column[index] = std::move(column.back());
+            column.pop_back();
+        });
+    }
+
+    void ParticleSystem::clear() noexcept
+    {
+        forEachColumn([](auto& column) { column.clear(); });
+    }
+
+    std::size_t ParticleSystem::size() const noexcept
+    {
+        return m_positions.size();
+    }
+
+    std::size_t ParticleSystem::capacity() const noexcept
+    {
+        return m_positions.capacity();
+    }
+
+    bool ParticleSystem::empty() const noexcept
+    {
+        return m_positions.empty();
+    }
+
+    Particle ParticleSystem::get(const std::size_t index) const noexcept
+    {
+        return { m_positions[index], m_velocities[index], m_masses[index], m_radii[index], m_charges[index], m_colors[index] };
+    }
+
+    std::span<glm::vec2> ParticleSystem::getPositions() noexcept
+    {
+        return m_positions;
+    }
+
+    std::span<const glm::vec2> ParticleSystem::getPositions() const noexcept
+    {
+        return m_positions;
+    }
+
+    std::span<const glm::vec2> ParticleSystem::getPreviousPositions() const noexcept
+    {
+        return m_previousPositions;
+    }
+
+    void ParticleSystem::storePreviousPositions() noexcept
+    {
+        std::ranges::copy(m_positions, m_previousPositions.begin());
+    }
+
+    std::span<glm::vec2> ParticleSystem::getVelocities() noexcept
+    {
+        return m_velocities;
+    }
+
+    std::span<const glm::vec2> ParticleSystem::getVelocities() const noexcept
+    {
+        return m_velocities;
+    }
+
+    std::span<glm::vec2> ParticleSystem::getAccelerations() noexcept
+    {
+        return m_accelerations;
+    }
+
+    std::span<const glm::vec2> ParticleSystem::getAccelerations() const noexcept
+    {
+        return m_accelerations;
+    }
+
+    std::span<float> ParticleSystem::getMasses() noexcept
+    {
+        return m_masses;
+    }
+
+    std::span<const float> ParticleSystem::getMasses() const noexcept
+    {
+        return m_masses;
+    }
+
+    std::span<float> ParticleSystem::getRadii() noexcept
+    {
+        return m_radii;
+    }
+
+    std::span<const float> ParticleSystem::getRadii() const noexcept
+    {
+        return m_radii;
+    }
+
+    std::span<float> ParticleSystem::getCharges() noexcept
+    {
+        return m_charges;
+    }
+
+    std::span<const float> ParticleSystem::getCharges() const noexcept
+    {
+        return m_charges;
+    }
+
+    std::span<glm::vec4> ParticleSystem::getColors() noexcept
+    {
+        return m_colors;
+    }
+
+    std::span<const glm::vec4> ParticleSystem::getColors() const noexcept
+    {
+        return m_colors;
+    }
+} // csv
@@ -0,0 +1,195 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/ProgramBinaryCache.h"
+
+#include <array>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <vector>
+#include "utilities/hash.h"
+
+namespace csv
+{
+    namespace
+    {
+        constexpr std::array<char, 8> MAGIC{ 'C', 'S', 'V', 'P', 'R', 'O', 'G', '1' };
+
+        struct EntryHeader
+        {
+            std::array<char, 8> magic;
+            std::uint64_t key;
+            GLenum format;
+            std::uint32_t length;
+        };
+
+        std::string_view getString(const GLenum name)
+        {
+            const auto* const value{ reinterpret_cast<const char*>(glGetString(name)) };
+            return value == nullptr ? std::string_view{} : std::string_view{ value };
+        }
+
+        std::filesystem::path getDefaultDirectory()
+        {
+            if (const auto* const cacheHome{ std::getenv("XDG_CACHE_HOME") }; cacheHome != nullptr && *cacheHome != '\0')
+            {
+                return std::filesystem::path{ cacheHome } / "conservation" / "programs";
+            }
+            if (const auto* const home{ std::getenv("HOME") }; home != nullptr && *home != '\0')
+            {
+                return std::filesystem::path{ home } / ".cache" / "conservation" / "programs";
+            }
+            return std::filesystem::temp_directory_path() / "conservation" / "programs";
+        }
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache(std::filesystem::path directory)
+        : m_directory{ std::move(directory) }
+    {
+    }
+
+    ProgramBinaryCache& ProgramBinaryCache::getDefault()
+    {
+        static ProgramBinaryCache cache{ getDefaultDirectory() };
+        return cache;
+    }
+
+    bool ProgramBinaryCache::isSupported() const
+    {
+        if (!m_supported.has_value())
+        {
+            GLint formatCount{};
+            if (GLAD_GL_ARB_get_program_binary != 0)
+            {
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+            }
+            m_supported = formatCount > 0;
+        }
+        return *m_supported;
+    }
+
+    void ProgramBinaryCache::prepareForCaching(const GLuint program) const
+    {
+        if (isSupported())
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+    }
+
+    std::uint64_t ProgramBinaryCache::makeKey(const std::span<const std::string_view> sources) const
+    {
+        // Binaries are only valid for the driver build that produced them
+        auto key{ fnv1a(getString(GL_VENDOR)) };
+        key = fnv1a(getString(GL_RENDERER), key);
+        key = fnv1a(getString(GL_VERSION), key);
+        for (const auto source : sources)
+        {
+            key = fnv1a(std::to_string(source.size()), key);
+            key = fnv1a(source, key);
+        }
+        return key;
+    }
+
+    bool ProgramBinaryCache::restore(const GLuint program, const std::uint64_t key) const
+    {
+        if (!isSupported())
+        {
+            return false;
+        }
+
+        std::ifstream file{ getEntryPath(key), std::ios::binary };
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        EntryHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != MAGIC || header.key != key)
+        {
+            file.close();
+            evict(key);
+            return false;
+        }
+        std::vector<char> binary(header.length);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!file)
+        {
+            file.close();
+            evict(key);
+            return false;
+        }
+
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+        return true;
+    }
+
+    void ProgramBinaryCache::evict(const std::uint64_t key) const
+    {
+        const auto entryPath{ getEntryPath(key) };
+        std::println(stderr, "Discarding stale program binary '{}'", entryPath.string());
+        std::error_code error{};
+        std::filesystem::remove(entryPath, error);
+    }
+
+    void ProgramBinaryCache::store(const GLuint program, const std::uint64_t key) const
+    {
+        if (!isSupported())
+        {
+            return;
+        }
+
+        GLint length{};
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        EntryHeader header{ MAGIC, key, 0, static_cast<std::uint32_t>(length) };
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        glGetProgramBinary(program, length, nullptr, &header.format, binary.data());
+
+        std::error_code error{};
+        std::filesystem::create_directories(m_directory, error);
+        if (error)
+        {
+            std::println(stderr, "Cannot create program cache directory '{}': {}", m_directory.string(), error.message());
+            return;
+        }
+
+        // Write next to the entry and rename so a concurrent reader never sees a partial file
+        const auto entryPath{ getEntryPath(key) };
+        auto temporaryPath{ entryPath };
+        temporaryPath += ".tmp";
+        {
+            std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+            if (!file)
+            {
+                std::println(stderr, "Failed to write program binary '{}'", temporaryPath.string());
+                return;
+            }
+        }
+        std::filesystem::rename(temporaryPath, entryPath, error);
+        if (error)
+        {
+            std::filesystem::remove(temporaryPath, error);
+        }
+    }
+
+    const std::filesystem::path& ProgramBinaryCache::getDirectory() const noexcept
+    {
+        return m_directory;
+    }
+
+    std::filesystem::path ProgramBinaryCache::getEntryPath(const std::uint64_t key) const
+    {
+        return m_directory / std::format("{:016x}.bin", key);
+    }
+} // csv
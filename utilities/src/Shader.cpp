@@ -5,11 +5,36 @@
 #include "utilities/Shader.h"
 
 #include <print>
+#include <utility>
 #include "utilities/file.h"
 
 namespace csv
 {
     Shader Shader::loadFromFile(const std::filesystem::path& shaderPath)
+    {
+        return loadFromFile(shaderPath, deduceType(shaderPath), true);
+    }
+
+    Shader Shader::loadFromFile(const std::filesystem::path& shaderPath, const Type shaderType)
+    {
+        return loadFromFile(shaderPath, shaderType, false);
+    }
+
+    Shader Shader::fromSource(const std::string_view source, const Type shaderType)
+    {
+        Shader shader{ shaderType };
+        shader.compileAndValidate(source);
+        return shader;
+    }
+
+    Shader Shader::submitSource(const std::string_view source, const Type shaderType)
+    {
+        Shader shader{ shaderType };
+        shader.compile(source);
+        return shader;
+    }
+
+    Shader::Type Shader::deduceType(const std::filesystem::path& shaderPath)
     {
         if (!std::filesystem::exists(shaderPath))
         {
@@ -24,25 +49,31 @@ namespace csv
             const auto extension{ shaderPath.extension().string() };
             if (extension == ".vert")
             {
-                return loadFromFile(shaderPath, Type::Vertex, true);
+                return Type::Vertex;
             }
             if (extension == ".frag")
             {
-                return loadFromFile(shaderPath, Type::Fragment, true);
+                return Type::Fragment;
             }
             throw std::runtime_error("Invalid/Unsupported shader file extension");
         }
         throw std::runtime_error("Unrecognized shader type");
     }
 
-    Shader Shader::loadFromFile(const std::filesystem::path& shaderPath, const Type shaderType)
+    Shader::Shader(Shader&& other) noexcept
+        : m_shaderId{ std::exchange(other.m_shaderId, 0) }
     {
-        return loadFromFile(shaderPath, shaderType, false);
     }
 
-    Shader::Shader(Shader&& other) noexcept = default;
-
-    Shader& Shader::operator=(Shader&& other) noexcept = default;
+    Shader& Shader::operator=(Shader&& other) noexcept
+    {
+        if (this != &other)
+        {
+            glDeleteShader(m_shaderId);
+            m_shaderId = std::exchange(other.m_shaderId, 0);
+        }
+        return *this;
+    }
 
     Shader::~Shader()
     {
@@ -68,7 +99,8 @@ namespace csv
     void Shader::compile(const std::string_view source) const
     {
         const auto rawSource{ source.data() };
-        glShaderSource(m_shaderId, 1, &rawSource, nullptr);
+        const auto length{ static_cast<GLint>(source.size()) };
+        glShaderSource(m_shaderId, 1, &rawSource, &length);
         glCompileShader(m_shaderId);
     }
 
@@ -92,9 +124,7 @@ namespace csv
                 throw std::runtime_error("Shader file is not a regular file");
             }
         }
-        Shader shader{ shaderType };
-        shader.compileAndValidate(readAll(shaderPath));
-        return shader;
+        return fromSource(readAll(shaderPath), shaderType);
     }
 
     void Shader::checkShaderCompilingSuccessfulness(const GLuint shaderId)
@@ -4,27 +4,74 @@
 
 #include "utilities/ShaderProgram.h"
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <print>
+#include <ranges>
+#include <string>
+#include <utility>
 #include <glm/gtc/type_ptr.hpp>
+#include "utilities/GlState.h"
+#include "utilities/ProgramBinaryCache.h"
 #include "utilities/file.h"
+#include "utilities/uniform_blocks.h"
 
 
 namespace csv
 {
+    namespace
+    {
+        void enableParallelCompilation()
+        {
+            static auto enabled{ false };
+            if (!enabled && GLAD_GL_KHR_parallel_shader_compile != 0)
+            {
+                // Let the driver pick as many compiler threads as it supports
+                glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+            }
+            enabled = true;
+        }
+    }
+
     ShaderProgram ShaderProgram::load(const std::filesystem::path& vertexShaderFile,
                                       const std::filesystem::path& fragmentShaderFile)
     {
-        const auto vertexShader{ Shader::loadFromFile(vertexShaderFile) };
+        const ShaderProgramFiles files{ vertexShaderFile, fragmentShaderFile };
+        auto pendingPrograms{ loadBatch({ &files, 1 }) };
+        return pendingPrograms.front().get();
+    }
 
-        const auto fragmentShader{ Shader::loadFromFile(fragmentShaderFile) };
+    std::vector<PendingShaderProgram> ShaderProgram::loadBatch(const std::span<const ShaderProgramFiles> programs)
+    {
+        enableParallelCompilation();
+        const auto& cache{ ProgramBinaryCache::getDefault() };
 
-        ShaderProgram shaderProgram{};
-        shaderProgram.attachShader(vertexShader);
-        shaderProgram.attachShader(fragmentShader);
-        shaderProgram.linkAndValidate();
+        std::vector<PendingShaderProgram> pendingPrograms{};
+        pendingPrograms.reserve(programs.size());
+        for (const auto& files : programs)
+        {
+            auto& pendingProgram{ pendingPrograms.emplace_back(PendingShaderProgram{ files }) };
+            pendingProgram.m_restoredFromCache = cache.restore(pendingProgram.m_program.m_programId,
+                                                               pendingProgram.m_cacheKey);
+        }
 
-        return shaderProgram;
+        // Compile every shader before linking anything so no compile waits behind a link
+        for (auto& pendingProgram : pendingPrograms)
+        {
+            if (!pendingProgram.m_restoredFromCache)
+            {
+                pendingProgram.submitCompilation();
+            }
+        }
+        for (auto& pendingProgram : pendingPrograms)
+        {
+            if (!pendingProgram.m_restoredFromCache)
+            {
+                pendingProgram.submitLinkage();
+            }
+        }
+        return pendingPrograms;
     }
 
     ShaderProgram::ShaderProgram(const GLuint program)
@@ -38,13 +85,26 @@ namespace csv
     }
 
     ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
-    = default;
+        : m_programId{ std::exchange(other.m_programId, 0) }
+        , m_uniformSlots{ std::move(other.m_uniformSlots) }
+    {
+    }
 
     ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
-    = default;
+    {
+        if (this != &other)
+        {
+            GlState::onProgramDeleted(m_programId);
+            glDeleteProgram(m_programId);
+            m_programId = std::exchange(other.m_programId, 0);
+            m_uniformSlots = std::move(other.m_uniformSlots);
+        }
+        return *this;
+    }
 
     ShaderProgram::~ShaderProgram()
     {
+        GlState::onProgramDeleted(m_programId);
         glDeleteProgram(m_programId);
     }
 
@@ -53,20 +113,28 @@ namespace csv
         return m_programId;
     }
 
-    GLint ShaderProgram::getUniformLocation(const std::string_view name) const
+    GLint ShaderProgram::getUniformLocation(const UniformName name) const
     {
-        const auto location{ glGetUniformLocation(m_programId, name.data()) };
-        if (location == -1)
+        const auto mask{ m_uniformSlots.size() - 1 };
+        for (auto index{ name.getHash() & mask }; !m_uniformSlots.empty(); index = (index + 1) & mask)
         {
-            std::println(stderr, "Uniform location '{}' not found", name);
-            throw std::runtime_error("Uniform location not found");
+            const auto& slot{ m_uniformSlots[index] };
+            if (slot.location == -1)
+            {
+                break;
+            }
+            if (slot.hash == name.getHash())
+            {
+                return slot.location;
+            }
         }
-        return location;
+        std::println(stderr, "Uniform location '{}' not found", name.getName());
+        throw std::runtime_error("Uniform location not found");
     }
 
     void ShaderProgram::use() const
     {
-        glUseProgram(m_programId);
+        GlState::useProgram(m_programId);
     }
 
     void ShaderProgram::setUniform(const GLint location, const GLint value)
@@ -318,9 +386,166 @@ namespace csv
         glLinkProgram(m_programId);
     }
 
-    void ShaderProgram::linkAndValidate() const
+    void ShaderProgram::linkAndValidate()
     {
         link();
         validate();
+        reflect();
+    }
+
+    void ShaderProgram::reflect()
+    {
+        reflectUniforms();
+        bindUniformBlocks();
+    }
+
+    void ShaderProgram::bindUniformBlocks() const
+    {
+        for (const auto& block : UNIFORM_BLOCKS)
+        {
+            const auto blockIndex{ glGetUniformBlockIndex(m_programId, block.name) };
+            if (blockIndex != GL_INVALID_INDEX)
+            {
+                glUniformBlockBinding(m_programId, blockIndex, block.binding);
+            }
+        }
+    }
+
+    void ShaderProgram::reflectUniforms()
+    {
+        GLint uniformCount{};
+        glGetProgramiv(m_programId, GL_ACTIVE_UNIFORMS, &uniformCount);
+        GLint maxNameLength{};
+        glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        // Arrays are reachable both as "name" and "name[0]", hence up to two entries per uniform
+        const auto capacity{ std::bit_ceil(std::max(4uz * static_cast<std::size_t>(uniformCount), 8uz)) };
+        m_uniformSlots.assign(capacity, UniformSlot{});
+
+        std::string name(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+        for (const auto index : std::views::iota(0, uniformCount))
+        {
+            GLsizei length{};
+            GLint size{};
+            GLenum type{};
+            glGetActiveUniform(m_programId,
+                               static_cast<GLuint>(index),
+                               static_cast<GLsizei>(name.size()),
+                               &length,
+                               &size,
+                               &type,
+                               name.data());
+            const auto location{ glGetUniformLocation(m_programId, name.c_str()) };
+            if (location == -1)
+            {
+                // Members of uniform blocks have no location
+                continue;
+            }
+
+            const std::string_view uniformName{ name.data(), static_cast<std::size_t>(length) };
+            insertUniform(uniformName, location);
+            if (uniformName.ends_with("[0]"))
+            {
+                insertUniform(uniformName.substr(0, uniformName.size() - 3), location);
+            }
+        }
+    }
+
+    void ShaderProgram::insertUniform(const std::string_view name, const GLint location)
+    {
+        const auto hash{ fnv1a(name) };
+        const auto mask{ m_uniformSlots.size() - 1 };
+        for (auto index{ hash & mask };; index = (index + 1) & mask)
+        {
+            auto& slot{ m_uniformSlots[index] };
+            if (slot.location == -1)
+            {
+                slot = { hash, location };
+                return;
+            }
+            if (slot.hash == hash)
+            {
+                std::println(stderr, "Uniform '{}' collides with another uniform in the location table", name);
+                throw std::runtime_error("Uniform name hash collision");
+            }
+        }
+    }
+    PendingShaderProgram::PendingShaderProgram(ShaderProgramFiles files)
+        : m_files{ std::move(files) }
+        , m_vertexShaderType{ Shader::deduceType(m_files.vertexShaderFile) }
+        , m_fragmentShaderType{ Shader::deduceType(m_files.fragmentShaderFile) }
+        , m_vertexSource{ readAll(m_files.vertexShaderFile) }
+        , m_fragmentSource{ readAll(m_files.fragmentShaderFile) }
+        , m_cacheKey{
+            ProgramBinaryCache::getDefault().makeKey(std::array<std::string_view, 2>{ m_vertexSource, m_fragmentSource })
+        }
+    {
+    }
+
+    bool PendingShaderProgram::isReady() const
+    {
+        if (GLAD_GL_KHR_parallel_shader_compile == 0)
+        {
+            return true;
+        }
+        GLint completed{};
+        glGetProgramiv(m_program.m_programId, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+
+    ShaderProgram PendingShaderProgram::get()
+    {
+        const auto& cache{ ProgramBinaryCache::getDefault() };
+        if (m_restoredFromCache)
+        {
+            GLint linked{};
+            glGetProgramiv(m_program.m_programId, GL_LINK_STATUS, &linked);
+            if (linked == GL_TRUE)
+            {
+                m_program.reflect();
+                return std::move(m_program);
+            }
+            // The driver rejected the binary, e.g. after an update that kept its version string
+            cache.evict(m_cacheKey);
+            m_restoredFromCache = false;
+            m_program = ShaderProgram{};
+            submitCompilation();
+            submitLinkage();
+        }
+
+        try
+        {
+            m_vertexShader->validate();
+            m_fragmentShader->validate();
+            m_program.validate();
+        }
+        catch (const std::runtime_error&)
+        {
+            std::println(stderr,
+                         "Failed to build program from '{}' and '{}'",
+                         m_files.vertexShaderFile.string(),
+                         m_files.fragmentShaderFile.string());
+            throw;
+        }
+        m_program.reflect();
+        cache.store(m_program.m_programId, m_cacheKey);
+
+        m_vertexShader.reset();
+        m_fragmentShader.reset();
+        return std::move(m_program);
+    }
+
+    void PendingShaderProgram::submitCompilation()
+    {
+        m_vertexShader = Shader::submitSource(m_vertexSource, m_vertexShaderType);
+        m_fragmentShader = Shader::submitSource(m_fragmentSource, m_fragmentShaderType);
+    }
+
+    void PendingShaderProgram::submitLinkage()
+    {
+        ProgramBinaryCache::getDefault().prepareForCaching(m_program.m_programId);
+        m_program.attachShader(*m_vertexShader);
+        m_program.attachShader(*m_fragmentShader);
+        m_program.link();
     }
 } // lgl
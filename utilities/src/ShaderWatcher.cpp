@@ -0,0 +1,175 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/ShaderWatcher.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <map>
+#include <print>
+#include <ranges>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace csv
+{
+    namespace
+    {
+        constexpr std::chrono::milliseconds POLL_INTERVAL{ 200 };
+    }
+
+    ShaderWatcher::ShaderWatcher(std::filesystem::path directory)
+        : m_directory{ std::move(directory) }
+    {
+#ifdef __linux__
+        m_inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyDescriptor == -1
+            || inotify_add_watch(m_inotifyDescriptor, m_directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+        {
+            std::println(stderr, "Failed to watch shader directory '{}'", m_directory.string());
+            throw std::runtime_error("Failed to watch shader directory");
+        }
+#endif
+        m_thread = std::jthread{ [this](const std::stop_token& stopToken) { run(stopToken); } };
+    }
+
+    ShaderWatcher::~ShaderWatcher()
+    {
+        m_thread.request_stop();
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+#ifdef __linux__
+        if (m_inotifyDescriptor != -1)
+        {
+            close(m_inotifyDescriptor);
+        }
+#endif
+    }
+
+    void ShaderWatcher::watch(ShaderProgram& program, ShaderProgramFiles files)
+    {
+        m_programs.push_back({ &program, std::move(files), std::nullopt });
+    }
+
+    void ShaderWatcher::update()
+    {
+        std::set<std::filesystem::path> changedFiles{};
+        {
+            std::scoped_lock lock{ m_mutex };
+            changedFiles.swap(m_changedFiles);
+        }
+
+        if (!changedFiles.empty())
+        {
+            std::vector<WatchedProgram*> affectedPrograms{};
+            std::vector<ShaderProgramFiles> affectedFiles{};
+            for (auto& watchedProgram : m_programs)
+            {
+                if (changedFiles.contains(watchedProgram.files.vertexShaderFile.filename())
+                    || changedFiles.contains(watchedProgram.files.fragmentShaderFile.filename()))
+                {
+                    affectedPrograms.push_back(&watchedProgram);
+                    affectedFiles.push_back(watchedProgram.files);
+                }
+            }
+
+            try
+            {
+                // A newer edit supersedes a rebuild that is still in flight
+                auto pendingPrograms{ ShaderProgram::loadBatch(affectedFiles) };
+                for (const auto index : std::views::iota(0uz, affectedPrograms.size()))
+                {
+                    affectedPrograms[index]->pendingProgram.emplace(std::move(pendingPrograms[index]));
+                }
+            }
+            catch (const std::exception& exception)
+            {
+                // Editors may briefly remove or truncate a file while saving; the next event retries
+                std::println(stderr, "Shader reload skipped: {}", exception.what());
+            }
+        }
+
+        for (auto& watchedProgram : m_programs)
+        {
+            if (!watchedProgram.pendingProgram.has_value() || !watchedProgram.pendingProgram->isReady())
+            {
+                continue;
+            }
+            try
+            {
+                *watchedProgram.program = watchedProgram.pendingProgram->get();
+                std::println("Reloaded shader program '{}' + '{}'",
+                             watchedProgram.files.vertexShaderFile.string(),
+                             watchedProgram.files.fragmentShaderFile.string());
+            }
+            catch (const std::exception& exception)
+            {
+                std::println(stderr, "Keeping previous shader program: {}", exception.what());
+            }
+            watchedProgram.pendingProgram.reset();
+        }
+    }
+
+    void ShaderWatcher::run(const std::stop_token& stopToken)
+    {
+#ifdef __linux__
+        alignas(inotify_event) std::array<char, 4096> buffer{};
+        pollfd descriptor{ m_inotifyDescriptor, POLLIN, 0 };
+        while (!stopToken.stop_requested())
+        {
+            if (poll(&descriptor, 1, static_cast<int>(POLL_INTERVAL.count())) <= 0)
+            {
+                continue;
+            }
+            ssize_t length{};
+            while ((length = read(m_inotifyDescriptor, buffer.data(), buffer.size())) > 0)
+            {
+                for (auto offset{ 0z }; offset < length;)
+                {
+                    const auto* const event{ reinterpret_cast<const inotify_event*>(buffer.data() + offset) };
+                    if (event->len > 0)
+                    {
+                        markChanged(event->name);
+                    }
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+        }
+#else
+        std::map<std::filesystem::path, std::filesystem::file_time_type> writeTimes{};
+        while (!stopToken.stop_requested())
+        {
+            std::error_code error{};
+            for (const auto& entry : std::filesystem::directory_iterator{ m_directory, error })
+            {
+                const auto writeTime{ entry.last_write_time(error) };
+                if (error)
+                {
+                    continue;
+                }
+                const auto [iterator, inserted]{ writeTimes.try_emplace(entry.path().filename(), writeTime) };
+                if (!inserted && iterator->second != writeTime)
+                {
+                    iterator->second = writeTime;
+                    markChanged(entry.path().filename());
+                }
+            }
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+#endif
+    }
+
+    void ShaderWatcher::markChanged(const std::filesystem::path& filename)
+    {
+        std::scoped_lock lock{ m_mutex };
+        m_changedFiles.insert(filename);
+    }
+} // csv
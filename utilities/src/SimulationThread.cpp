@@ -0,0 +1,118 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/SimulationThread.h"
+
+#include <algorithm>
+#include <ranges>
+#include <utility>
+
+namespace csv
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        using Seconds = std::chrono::duration<double>;
+
+        // Copies a column into a snapshot, reusing the snapshot's storage once it is large enough
+        template<typename T>
+        void copyColumn(const std::span<const T> source, AlignedVector<T>& destination)
+        {
+            destination.assign(source.begin(), source.end());
+        }
+    }
+
+    float SimulationSnapshot::getInterpolation(const std::chrono::steady_clock::time_point frameTime) const noexcept
+    {
+        if (stepSeconds <= 0.0)
+        {
+            return 1.0f;
+        }
+        return static_cast<float>(std::clamp(Seconds{ frameTime - dueTime }.count() / stepSeconds, 0.0, 1.0));
+    }
+
+    SimulationThread::SimulationThread(ParticleSystem particles,
+                                       StepFunction stepFunction,
+                                       const double stepSeconds,
+                                       const std::size_t maxStepsPerBatch)
+        : m_particles{ std::move(particles) }
+        , m_stepFunction{ std::move(stepFunction) }
+        , m_timestep{ stepSeconds, maxStepsPerBatch }
+    {
+        // The initial state is published before the thread starts, so a reader always has something to show
+        m_particles.storePreviousPositions();
+        publish(Clock::now());
+        m_thread = std::jthread{ [this](const std::stop_token& stopToken) { run(stopToken); } };
+    }
+
+    SimulationThread::~SimulationThread()
+    {
+        m_thread.request_stop();
+        m_thread.join();
+    }
+
+    const SimulationSnapshot& SimulationThread::getLatestSnapshot() noexcept
+    {
+        m_snapshots.update();
+        return m_snapshots.getReadBuffer();
+    }
+
+    std::uint64_t SimulationThread::getDroppedSteps() const noexcept
+    {
+        return m_droppedSteps.load(std::memory_order_relaxed);
+    }
+
+    void SimulationThread::run(const std::stop_token& stopToken)
+    {
+        const auto stepSeconds{ m_timestep.getStepSeconds() };
+        auto previousTime{ Clock::now() };
+
+        while (!stopToken.stop_requested())
+        {
+            const auto now{ Clock::now() };
+            const auto steps{ m_timestep.advance(Seconds{ now - previousTime }.count()) };
+            previousTime = now;
+
+            for (const auto step : std::views::iota(0uz, steps))
+            {
+                // Only the state before the final step is needed for interpolation
+                if (step + 1 == steps)
+                {
+                    m_particles.storePreviousPositions();
+                }
+                m_stepFunction(m_particles, static_cast<float>(stepSeconds));
+                ++m_step;
+                m_time += stepSeconds;
+            }
+            if (steps > 0)
+            {
+                // The newest state was due when the accumulator last crossed a step boundary
+                const auto lag{ Seconds{ m_timestep.getInterpolation() * stepSeconds } };
+                publish(now - std::chrono::duration_cast<Clock::duration>(lag));
+                m_droppedSteps.store(m_timestep.getDroppedSteps(), std::memory_order_relaxed);
+            }
+
+            // Sleep until the next step is due
+            const auto remaining{ (1.0 - m_timestep.getInterpolation()) * stepSeconds };
+            std::this_thread::sleep_for(Seconds{ remaining });
+        }
+    }
+
+    void SimulationThread::publish(const std::chrono::steady_clock::time_point dueTime)
+    {
+        auto& snapshot{ m_snapshots.getWriteBuffer() };
+        snapshot.step = m_step;
+        snapshot.time = m_time;
+        snapshot.stepSeconds = m_timestep.getStepSeconds();
+        snapshot.dueTime = dueTime;
+
+        const auto& particles{ std::as_const(m_particles) };
+        copyColumn(particles.getPositions(), snapshot.positions);
+        copyColumn(particles.getPreviousPositions(), snapshot.previousPositions);
+        copyColumn(particles.getRadii(), snapshot.radii);
+        copyColumn(particles.getColors(), snapshot.colors);
+
+        m_snapshots.publish();
+    }
+} // csv
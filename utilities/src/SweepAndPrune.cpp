@@ -0,0 +1,105 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/SweepAndPrune.h"
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+#include <glm/glm.hpp>
+
+namespace csv
+{
+    void SweepAndPrune::findPairs(const ParticleSystem& particles, std::vector<CandidatePair>& pairs)
+    {
+        pairs.clear();
+        if (particles.size() != m_intervals.size())
+        {
+            rebuild(particles);
+        }
+        else
+        {
+            refresh(particles);
+            insertionSort();
+        }
+
+        // Every interval that starts before the current one ends overlaps it on the sweep axis
+        for (auto first{ m_intervals.begin() }; first != m_intervals.end(); ++first)
+        {
+            for (auto second{ first + 1 }; second != m_intervals.end() && second->lower <= first->upper; ++second)
+            {
+                if (first->crossLower <= second->crossUpper && second->crossLower <= first->crossUpper)
+                {
+                    pairs.push_back({ std::min(first->index, second->index), std::max(first->index, second->index) });
+                }
+            }
+        }
+    }
+
+    std::size_t SweepAndPrune::getLastSortMoves() const noexcept
+    {
+        return m_lastSortMoves;
+    }
+
+    void SweepAndPrune::rebuild(const ParticleSystem& particles)
+    {
+        const auto positions{ particles.getPositions() };
+
+        // Sweep along the axis with the larger spread, where fewer intervals overlap
+        glm::vec2 lower{ std::numeric_limits<float>::max() };
+        glm::vec2 upper{ std::numeric_limits<float>::lowest() };
+        for (const auto& position : positions)
+        {
+            lower = glm::min(lower, position);
+            upper = glm::max(upper, position);
+        }
+        m_axis = upper.x - lower.x >= upper.y - lower.y ? 0 : 1;
+
+        m_intervals.resize(particles.size());
+        for (const auto index : std::views::iota(0uz, particles.size()))
+        {
+            m_intervals[index].index = static_cast<std::uint32_t>(index);
+        }
+        refresh(particles);
+        std::ranges::sort(m_intervals, {}, &Interval::lower);
+        m_lastSortMoves = m_intervals.size();
+    }
+
+    void SweepAndPrune::refresh(const ParticleSystem& particles) noexcept
+    {
+        const auto positions{ particles.getPositions() };
+        const auto radii{ particles.getRadii() };
+        const auto crossAxis{ 1 - m_axis };
+        for (auto& interval : m_intervals)
+        {
+            const auto& position{ positions[interval.index] };
+            const auto radius{ radii[interval.index] };
+            interval.lower = position[m_axis] - radius;
+            interval.upper = position[m_axis] + radius;
+            interval.crossLower = position[crossAxis] - radius;
+            interval.crossUpper = position[crossAxis] + radius;
+        }
+    }
+
+    void SweepAndPrune::insertionSort() noexcept
+    {
+        m_lastSortMoves = 0;
+        for (auto current{ m_intervals.begin() + (m_intervals.empty() ? 0 : 1) }; current < m_intervals.end(); ++current)
+        {
+            if (!(current->lower < (current - 1)->lower))
+            {
+                continue;
+            }
+            const auto interval{ *current };
+            auto position{ current };
+            do
+            {
+                *position = *(position - 1);
+                --position;
+                ++m_lastSortMoves;
+            } while (position != m_intervals.begin() && interval.lower < (position - 1)->lower);
+            *position = interval;
+        }
+    }
+} // csv
@@ -0,0 +1,277 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/TaskGraph.h"
+
+#include <algorithm>
+#include <format>
+#include <print>
+#include <ranges>
+#include <stdexcept>
+
+namespace csv
+{
+    namespace
+    {
+        double millisecondsBetween(const std::chrono::steady_clock::time_point begin,
+                                   const std::chrono::steady_clock::time_point end)
+        {
+            return std::chrono::duration<double, std::milli>(end - begin).count();
+        }
+    }
+
+    TaskGraph::TaskGraph(JobSystem* jobSystem)
+        : m_jobSystem{ jobSystem }
+    {
+    }
+
+    TaskGraph::~TaskGraph() = default;
+
+    TaskGraph::TaskId TaskGraph::add(std::string name,
+                                     const Affinity affinity,
+                                     std::function<Task()> function,
+                                     const std::initializer_list<TaskId> dependencies)
+    {
+        const auto id{ m_nodes.size() };
+        for (const auto dependency : dependencies)
+        {
+            if (dependency >= id)
+            {
+                std::println(stderr, "Task '{}' depends on task {}, which has not been added", name, dependency);
+                throw std::runtime_error("Task dependency not in graph");
+            }
+            m_nodes[dependency]->successors.push_back(id);
+        }
+
+        auto node{ std::make_unique<Node>(std::move(name), affinity, std::move(function), dependencies) };
+        node->job = { &resumeTask, node.get(), 0, nullptr };
+        m_nodes.push_back(std::move(node));
+        return id;
+    }
+
+    void TaskGraph::run()
+    {
+        m_contextThread = std::this_thread::get_id();
+        m_runStart = Clock::now();
+
+        // Everything is reset before the first task is released, since any task may finish and touch its successors
+        for (const auto id : std::views::iota(0uz, m_nodes.size()))
+        {
+            auto& node{ *m_nodes[id] };
+            node.task = node.function();
+            node.task.m_handle.promise().graph = this;
+            node.task.m_handle.promise().id = id;
+            node.waitingOn.store(node.dependencies.size(), std::memory_order_relaxed);
+            node.threadSwitches = 0;
+        }
+        m_remaining.store(m_nodes.size(), std::memory_order_release);
+
+        for (const auto id : std::views::iota(0uz, m_nodes.size()))
+        {
+            if (m_nodes[id]->dependencies.empty())
+            {
+                m_nodes[id]->readyTime = m_runStart;
+                enqueue(id, m_nodes[id]->affinity);
+            }
+        }
+
+        while (m_remaining.load(std::memory_order_acquire) != 0)
+        {
+            if (const auto id{ takeContextTask() })
+            {
+                m_nodes[*id]->task.m_handle.resume();
+            }
+            else if (m_jobSystem == nullptr || !m_jobSystem->runQueuedJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        for (const auto& node : m_nodes)
+        {
+            node->task = {};
+        }
+        collectTimings();
+
+        std::exception_ptr exception{};
+        {
+            const std::scoped_lock lock{ m_mutex };
+            exception = std::exchange(m_exception, nullptr);
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    TaskGraph::ThreadSwitch TaskGraph::resumeOn(const Affinity affinity) noexcept
+    {
+        return { *this, affinity };
+    }
+
+    std::span<const TaskGraph::TaskTiming> TaskGraph::getTimings() const noexcept
+    {
+        return m_timings;
+    }
+
+    std::string TaskGraph::toDot() const
+    {
+        std::string dot{ "digraph TaskGraph\n{\n    node [shape=box];\n" };
+        for (const auto id : std::views::iota(0uz, m_nodes.size()))
+        {
+            const auto& node{ *m_nodes[id] };
+            const auto color{ id < m_timings.size() && m_timings[id].isCritical ? "red" : "black" };
+            dot += std::format("    task{} [label=\"{}\\n{}", id, node.name,
+                               node.affinity == Affinity::Context ? "context" : "any");
+            if (id < m_timings.size())
+            {
+                const auto& timing{ m_timings[id] };
+                dot += std::format("\\n{:.3f} - {:.3f} ms", timing.startMilliseconds, timing.finishMilliseconds);
+            }
+            dot += std::format("\", color={}];\n", color);
+
+            // Only the dependency that released a critical task is on the path
+            const auto releasedBy{ id < m_timings.size() && !node.dependencies.empty()
+                                       ? std::optional{ latestFinished(node.dependencies) }
+                                       : std::nullopt };
+            for (const auto dependency : node.dependencies)
+            {
+                const auto isCritical{ releasedBy && m_timings[id].isCritical && dependency == *releasedBy };
+                dot += std::format("    task{} -> task{} [color={}];\n", dependency, id, isCritical ? "red" : "black");
+            }
+        }
+        dot += "}\n";
+        return dot;
+    }
+
+    bool TaskGraph::hasWorkers() const noexcept
+    {
+        return m_jobSystem != nullptr && m_jobSystem->getWorkerCount() > 0;
+    }
+
+    bool TaskGraph::isOn(const Affinity affinity) const noexcept
+    {
+        const auto onContextThread{ std::this_thread::get_id() == m_contextThread };
+        return affinity == Affinity::Context ? onContextThread : !onContextThread || !hasWorkers();
+    }
+
+    void TaskGraph::enqueue(const TaskId id, const Affinity affinity)
+    {
+        if (affinity == Affinity::Any && hasWorkers() && m_jobSystem->trySubmit(m_nodes[id]->job))
+        {
+            return;
+        }
+        const std::scoped_lock lock{ m_mutex };
+        m_contextQueue.push_back(id);
+    }
+
+    bool TaskGraph::switchTo(const TaskId id, const Affinity affinity)
+    {
+        // Counted first: once handed over, the task may already be running elsewhere
+        auto& node{ *m_nodes[id] };
+        ++node.threadSwitches;
+        if (affinity == Affinity::Context)
+        {
+            const std::scoped_lock lock{ m_mutex };
+            m_contextQueue.push_back(id);
+            return true;
+        }
+        if (m_jobSystem->trySubmit(node.job))
+        {
+            return true;
+        }
+        --node.threadSwitches;
+        return false;
+    }
+
+    std::optional<TaskGraph::TaskId> TaskGraph::takeContextTask()
+    {
+        const std::scoped_lock lock{ m_mutex };
+        if (m_contextQueue.empty())
+        {
+            return std::nullopt;
+        }
+        const auto id{ m_contextQueue.front() };
+        m_contextQueue.pop_front();
+        return id;
+    }
+
+    void TaskGraph::onStarted(const TaskId id) noexcept
+    {
+        m_nodes[id]->startTime = Clock::now();
+    }
+
+    void TaskGraph::onFinished(const TaskId id) noexcept
+    {
+        auto& node{ *m_nodes[id] };
+        node.finishTime = Clock::now();
+        for (const auto successorId : node.successors)
+        {
+            auto& successor{ *m_nodes[successorId] };
+            if (successor.waitingOn.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                successor.readyTime = node.finishTime;
+                enqueue(successorId, successor.affinity);
+            }
+        }
+        // Last: run() may return, and destroy this coroutine, as soon as the count reaches zero
+        m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void TaskGraph::onException(std::exception_ptr exception) noexcept
+    {
+        const std::scoped_lock lock{ m_mutex };
+        if (!m_exception)
+        {
+            m_exception = std::move(exception);
+        }
+    }
+
+    void TaskGraph::collectTimings()
+    {
+        m_timings.clear();
+        for (const auto& node : m_nodes)
+        {
+            m_timings.push_back({
+                .name = node->name,
+                .affinity = node->affinity,
+                .readyMilliseconds = millisecondsBetween(m_runStart, node->readyTime),
+                .startMilliseconds = millisecondsBetween(m_runStart, node->startTime),
+                .finishMilliseconds = millisecondsBetween(m_runStart, node->finishTime),
+                .threadSwitches = node->threadSwitches,
+                .isCritical = false
+            });
+        }
+        if (m_timings.empty())
+        {
+            return;
+        }
+
+        // Walk back from the last task to finish, each time through the dependency that released it
+        auto id{ std::ranges::max(std::views::iota(0uz, m_timings.size()), {}, [this](const TaskId task)
+        {
+            return m_timings[task].finishMilliseconds;
+        }) };
+        while (true)
+        {
+            m_timings[id].isCritical = true;
+            const auto& dependencies{ m_nodes[id]->dependencies };
+            if (dependencies.empty())
+            {
+                break;
+            }
+            id = latestFinished(dependencies);
+        }
+    }
+
+    TaskGraph::TaskId TaskGraph::latestFinished(const std::span<const TaskId> ids) const
+    {
+        return std::ranges::max(ids, {}, [this](const TaskId id) { return m_timings[id].finishMilliseconds; });
+    }
+
+    void TaskGraph::resumeTask(const void* node, std::size_t)
+    {
+        static_cast<const Node*>(node)->task.m_handle.resume();
+    }
+} // csv
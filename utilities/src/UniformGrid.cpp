@@ -0,0 +1,215 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/UniformGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ranges>
+
+namespace csv
+{
+    namespace
+    {
+        // Upper bound on cells per particle, so a few distant particles cannot blow up the cell array
+        constexpr std::size_t MAX_CELLS_PER_PARTICLE{ 4 };
+
+        // Particles per job when locating cells
+        constexpr std::size_t CELL_GRAIN{ 16384 };
+
+        // Particles per band of rows in the pair search
+        constexpr std::size_t PAIR_GRAIN{ 4096 };
+
+        // Written as interval tests on the box edges, the same rounding as the other broadphases use
+        bool boundsOverlap(const glm::vec2& firstPosition,
+                           const float firstRadius,
+                           const glm::vec2& secondPosition,
+                           const float secondRadius) noexcept
+        {
+            // Non-short-circuiting so the test compiles to a single, rarely taken branch
+            return (firstPosition.x - firstRadius <= secondPosition.x + secondRadius)
+                   & (secondPosition.x - secondRadius <= firstPosition.x + firstRadius)
+                   & (firstPosition.y - firstRadius <= secondPosition.y + secondRadius)
+                   & (secondPosition.y - secondRadius <= firstPosition.y + firstRadius);
+        }
+    }
+
+    UniformGrid::UniformGrid(const float cellSize) noexcept
+        : m_requestedCellSize{ cellSize }
+    {
+    }
+
+    void UniformGrid::findPairs(const ParticleSystem& particles, std::vector<CandidatePair>& pairs)
+    {
+        pairs.clear();
+        if (particles.size() < 2)
+        {
+            return;
+        }
+        build(particles);
+
+        // Bands of rows sized to cover about PAIR_GRAIN particles each. Every band collects its own pairs and the
+        // bands are concatenated in order, so the output matches a serial search exactly
+        const auto rowGrain{ std::max(PAIR_GRAIN * m_rows / particles.size(), 1uz) };
+        const auto bandCount{ (m_rows + rowGrain - 1) / rowGrain };
+        if (m_jobSystem == nullptr || bandCount == 1)
+        {
+            searchRows(0, m_rows, pairs);
+            return;
+        }
+
+        m_bandPairs.resize(bandCount);
+        parallelFor(m_jobSystem, 0, m_rows, rowGrain, [&](const std::size_t begin, const std::size_t end)
+        {
+            auto& bandPairs{ m_bandPairs[begin / rowGrain] };
+            bandPairs.clear();
+            searchRows(static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end), bandPairs);
+        });
+
+        auto pairCount{ 0uz };
+        for (const auto& bandPairs : m_bandPairs | std::views::take(bandCount))
+        {
+            pairCount += bandPairs.size();
+        }
+        pairs.reserve(pairCount);
+        for (const auto& bandPairs : m_bandPairs | std::views::take(bandCount))
+        {
+            pairs.insert(pairs.end(), bandPairs.begin(), bandPairs.end());
+        }
+    }
+
+    void UniformGrid::setJobSystem(JobSystem* jobSystem) noexcept
+    {
+        m_jobSystem = jobSystem;
+    }
+
+    float UniformGrid::getCellSize() const noexcept
+    {
+        return m_cellSize;
+    }
+
+    glm::uvec2 UniformGrid::getDimensions() const noexcept
+    {
+        return { m_columns, m_rows };
+    }
+
+    void UniformGrid::build(const ParticleSystem& particles)
+    {
+        const auto positions{ particles.getPositions() };
+        const auto radii{ particles.getRadii() };
+        const auto count{ particles.size() };
+
+        glm::vec2 lower{ std::numeric_limits<float>::max() };
+        glm::vec2 upper{ std::numeric_limits<float>::lowest() };
+        auto maxRadius{ 0.0f };
+        for (const auto index : std::views::iota(0uz, count))
+        {
+            lower = glm::min(lower, positions[index]);
+            upper = glm::max(upper, positions[index]);
+            maxRadius = std::max(maxRadius, radii[index]);
+        }
+
+        const auto extent{ upper - lower };
+        m_cellSize = std::max({ m_requestedCellSize,
+                                2.0f * maxRadius,
+                                std::max(extent.x, extent.y) / static_cast<float>(count),
+                                std::numeric_limits<float>::min() });
+        const auto dimensionsFor{ [&](const float cellSize)
+        {
+            return glm::dvec2{ std::floor(extent.x / cellSize) + 1.0, std::floor(extent.y / cellSize) + 1.0 };
+        } };
+        while (dimensionsFor(m_cellSize).x * dimensionsFor(m_cellSize).y
+               > static_cast<double>(MAX_CELLS_PER_PARTICLE * count))
+        {
+            m_cellSize *= 2.0f;
+        }
+        m_origin = lower;
+        m_columns = static_cast<std::uint32_t>(dimensionsFor(m_cellSize).x);
+        m_rows = static_cast<std::uint32_t>(dimensionsFor(m_cellSize).y);
+        const auto cellCount{ static_cast<std::size_t>(m_columns) * m_rows };
+
+        // Counting sort: histogram of cell populations, prefix sum into offsets, then scatter
+        m_cellStarts.assign(cellCount + 1, 0);
+        m_particleCells.resize(count);
+        const auto inverseCellSize{ 1.0f / m_cellSize };
+        parallelFor(m_jobSystem, 0, count, CELL_GRAIN, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (const auto index : std::views::iota(begin, end))
+            {
+                const auto local{ (positions[index] - m_origin) * inverseCellSize };
+                const auto column{ std::min(static_cast<std::uint32_t>(local.x), m_columns - 1) };
+                const auto row{ std::min(static_cast<std::uint32_t>(local.y), m_rows - 1) };
+                m_particleCells[index] = row * m_columns + column;
+            }
+        });
+        for (const auto cell : m_particleCells)
+        {
+            ++m_cellStarts[cell + 1];
+        }
+        for (const auto cell : std::views::iota(0uz, cellCount))
+        {
+            m_cellStarts[cell + 1] += m_cellStarts[cell];
+        }
+
+        m_cellCursors.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+        m_sortedParticles.resize(count);
+        for (const auto index : std::views::iota(0uz, count))
+        {
+            m_sortedParticles[m_cellCursors[m_particleCells[index]]++] = {
+                positions[index], radii[index], static_cast<std::uint32_t>(index)
+            };
+        }
+    }
+
+    void UniformGrid::searchRows(const std::uint32_t beginRow,
+                                 const std::uint32_t endRow,
+                                 std::vector<CandidatePair>& pairs) const
+    {
+        // Visit each neighbouring cell pair once: the cell with the cell to its right, and with the three cells
+        // above it. Cells are stored row-major, so each of those neighbourhoods is one contiguous slot range
+        for (const auto row : std::views::iota(beginRow, endRow))
+        {
+            for (const auto column : std::views::iota(0u, m_columns))
+            {
+                const auto cell{ row * m_columns + column };
+                const auto begin{ m_cellStarts[cell] };
+                const auto end{ m_cellStarts[cell + 1] };
+                if (begin == end)
+                {
+                    continue;
+                }
+
+                const auto hasLeft{ column > 0 ? 1u : 0u };
+                const auto hasRight{ column + 1 < m_columns ? 1u : 0u };
+                const auto sideEnd{ m_cellStarts[cell + 1 + hasRight] };
+                const auto above{ cell + m_columns };
+                const auto aboveBegin{ row + 1 < m_rows ? m_cellStarts[above - hasLeft] : 0u };
+                const auto aboveEnd{ row + 1 < m_rows ? m_cellStarts[above + 1 + hasRight] : 0u };
+
+                for (auto slot{ begin }; slot < end; ++slot)
+                {
+                    collideRange(slot, slot + 1, sideEnd, pairs);
+                    collideRange(slot, aboveBegin, aboveEnd, pairs);
+                }
+            }
+        }
+    }
+
+    void UniformGrid::collideRange(const std::uint32_t slot,
+                                   const std::uint32_t begin,
+                                   const std::uint32_t end,
+                                   std::vector<CandidatePair>& pairs) const
+    {
+        const auto& particle{ m_sortedParticles[slot] };
+        for (auto otherSlot{ begin }; otherSlot < end; ++otherSlot)
+        {
+            const auto& other{ m_sortedParticles[otherSlot] };
+            if (boundsOverlap(particle.position, particle.radius, other.position, other.radius))
+            {
+                pairs.push_back({ std::min(particle.index, other.index), std::max(particle.index, other.index) });
+            }
+        }
+    }
+} // csv
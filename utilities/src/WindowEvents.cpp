@@ -0,0 +1,109 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/WindowEvents.h"
+
+#include <algorithm>
+
+namespace csv
+{
+    namespace
+    {
+        WindowEvents& getWindowEvents(GLFWwindow* window)
+        {
+            return *static_cast<WindowEvents*>(glfwGetWindowUserPointer(window));
+        }
+    }
+
+    bool FrameEvents::wasKeyPressed(const int key) const noexcept
+    {
+        return std::ranges::any_of(buttons, [key](const WindowEvent& event)
+        {
+            return event.type == WindowEvent::Type::Key && event.code == key && event.action == GLFW_PRESS;
+        });
+    }
+
+    WindowEvents::WindowEvents(GLFWwindow* window)
+        : m_window{ window }
+    {
+        glfwSetWindowUserPointer(window, this);
+
+        glfwSetFramebufferSizeCallback(window, [](GLFWwindow* source, const int width, const int height)
+        {
+            getWindowEvents(source).push({ WindowEvent::Type::FramebufferResize, 0, 0, 0, { width, height } });
+        });
+        glfwSetKeyCallback(window, [](GLFWwindow* source, const int key, int, const int action, const int modifiers)
+        {
+            getWindowEvents(source).push({ WindowEvent::Type::Key, key, action, modifiers, {} });
+        });
+        glfwSetMouseButtonCallback(window,
+                                   [](GLFWwindow* source, const int button, const int action, const int modifiers)
+        {
+            getWindowEvents(source).push({ WindowEvent::Type::MouseButton, button, action, modifiers, {} });
+        });
+        glfwSetCursorPosCallback(window, [](GLFWwindow* source, const double x, const double y)
+        {
+            getWindowEvents(source).push({ WindowEvent::Type::CursorMove, 0, 0, 0, { x, y } });
+        });
+        glfwSetScrollCallback(window, [](GLFWwindow* source, const double x, const double y)
+        {
+            getWindowEvents(source).push({ WindowEvent::Type::Scroll, 0, 0, 0, { x, y } });
+        });
+    }
+
+    WindowEvents::~WindowEvents()
+    {
+        glfwSetFramebufferSizeCallback(m_window, nullptr);
+        glfwSetKeyCallback(m_window, nullptr);
+        glfwSetMouseButtonCallback(m_window, nullptr);
+        glfwSetCursorPosCallback(m_window, nullptr);
+        glfwSetScrollCallback(m_window, nullptr);
+        glfwSetWindowUserPointer(m_window, nullptr);
+    }
+
+    const FrameEvents& WindowEvents::drain()
+    {
+        auto& frameEvents{ m_frameEvents };
+        frameEvents.framebufferSize.reset();
+        frameEvents.cursorPosition.reset();
+        frameEvents.scroll = glm::dvec2{ 0.0 };
+        frameEvents.buttons.clear();
+        frameEvents.receivedCount = 0;
+
+        while (const auto event{ m_queue.pop() })
+        {
+            ++frameEvents.receivedCount;
+            switch (event->type)
+            {
+            case WindowEvent::Type::FramebufferResize:
+                frameEvents.framebufferSize = glm::ivec2{ event->value };
+                break;
+            case WindowEvent::Type::CursorMove:
+                frameEvents.cursorPosition = event->value;
+                break;
+            case WindowEvent::Type::Scroll:
+                frameEvents.scroll += event->value;
+                break;
+            case WindowEvent::Type::Key:
+            case WindowEvent::Type::MouseButton:
+                frameEvents.buttons.push_back(*event);
+                break;
+            }
+        }
+        return frameEvents;
+    }
+
+    std::uint64_t WindowEvents::getDroppedCount() const noexcept
+    {
+        return m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+    void WindowEvents::push(const WindowEvent& event) noexcept
+    {
+        if (!m_queue.push(event))
+        {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+} // csv
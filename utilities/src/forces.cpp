@@ -0,0 +1,170 @@
+//
+// Created by user on 10/16/26.
+//
+
+#include "utilities/forces.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <ranges>
+#include <vector>
+#include "utilities/simd.h"
+
+namespace csv
+{
+    namespace
+    {
+        using FloatBatch = NativeSimd<float>;
+
+        // Massless padding this far away contributes nothing, while its squared distance still fits in a float
+        constexpr float PADDING_COORDINATE{ 1e18f };
+
+        // Targets per job; each job streams every source tile past its targets
+        constexpr std::size_t TARGET_GRAIN{ 256 };
+
+        // Sums the field of every source on every target, one tile of sources at a time. Each tile is summed
+        // in float lanes and added to per-target totals of type Accumulator
+        template<typename Accumulator>
+        double sumPairs(const ParticleSystem& particles,
+                        const std::span<glm::vec2> accelerations,
+                        const DirectGravity& settings)
+        {
+            constexpr auto LANES{ FloatBatch::size() };
+            static_assert(DirectGravity::TILE_SIZE % LANES == 0);
+
+            const auto positions{ particles.getPositions() };
+            const auto masses{ particles.getMasses() };
+            const auto count{ particles.size() };
+            const auto paddedCount{ (count + LANES - 1) / LANES * LANES };
+            const auto softeningSquared{ settings.softening * settings.softening };
+
+            // Sources in structure-of-arrays form, so that one load fills a batch
+            AlignedVector<float> sourceX(paddedCount, PADDING_COORDINATE);
+            AlignedVector<float> sourceY(paddedCount, PADDING_COORDINATE);
+            AlignedVector<float> sourceMasses(paddedCount, 0.0f);
+            for (const auto index : std::views::iota(0uz, count))
+            {
+                sourceX[index] = positions[index].x;
+                sourceY[index] = positions[index].y;
+                sourceMasses[index] = masses[index];
+            }
+
+            const auto sumTargets{ [&](const std::size_t targetBegin, const std::size_t targetEnd)
+            {
+                const auto targetCount{ targetEnd - targetBegin };
+                std::vector<Accumulator> fieldX(targetCount);
+                std::vector<Accumulator> fieldY(targetCount);
+                std::vector<Accumulator> potentials(targetCount);
+
+                for (auto tileBegin{ 0uz }; tileBegin < paddedCount; tileBegin += DirectGravity::TILE_SIZE)
+                {
+                    const auto tileEnd{ std::min(tileBegin + DirectGravity::TILE_SIZE, paddedCount) };
+                    for (const auto target : std::views::iota(targetBegin, targetEnd))
+                    {
+                        const auto targetX{ sourceX[target] };
+                        const auto targetY{ sourceY[target] };
+                        FloatBatch accelerationX{ 0.0f };
+                        FloatBatch accelerationY{ 0.0f };
+                        FloatBatch potential{ 0.0f };
+                        auto selfBatchX{ 0.0f };
+                        auto selfBatchY{ 0.0f };
+                        auto selfBatchPotential{ 0.0f };
+
+                        for (auto batch{ tileBegin }; batch < tileEnd; batch += LANES)
+                        {
+                            // The batch holding the target itself is summed lane by lane so the target can be
+                            // skipped
+                            if (target - batch < LANES)
+                            {
+                                for (const auto source : std::views::iota(batch, batch + LANES))
+                                {
+                                    if (source == target)
+                                    {
+                                        continue;
+                                    }
+                                    const auto separationX{ sourceX[source] - targetX };
+                                    const auto separationY{ sourceY[source] - targetY };
+                                    const auto inverseDistance{ 1.0f / std::sqrt(separationX * separationX
+                                                                                 + separationY * separationY
+                                                                                 + softeningSquared) };
+                                    const auto massOverDistance{ sourceMasses[source] * inverseDistance };
+                                    const auto strength{ massOverDistance * inverseDistance * inverseDistance };
+                                    selfBatchX += separationX * strength;
+                                    selfBatchY += separationY * strength;
+                                    selfBatchPotential += massOverDistance;
+                                }
+                                continue;
+                            }
+
+                            const auto separationX{ loadSimd(sourceX.data() + batch) - targetX };
+                            const auto separationY{ loadSimd(sourceY.data() + batch) - targetY };
+                            const auto inverseDistance{ 1.0f / sqrtSimd(separationX * separationX
+                                                                        + separationY * separationY
+                                                                        + softeningSquared) };
+                            const auto massOverDistance{ loadSimd(sourceMasses.data() + batch) * inverseDistance };
+                            const auto strength{ massOverDistance * inverseDistance * inverseDistance };
+                            accelerationX += separationX * strength;
+                            accelerationY += separationY * strength;
+                            potential += massOverDistance;
+                        }
+
+                        const auto local{ target - targetBegin };
+                        fieldX[local] += static_cast<Accumulator>(reduceSimd(accelerationX) + selfBatchX);
+                        fieldY[local] += static_cast<Accumulator>(reduceSimd(accelerationY) + selfBatchY);
+                        potentials[local] += static_cast<Accumulator>(reduceSimd(potential) + selfBatchPotential);
+                    }
+                }
+
+                auto potentialEnergy{ 0.0 };
+                for (const auto target : std::views::iota(targetBegin, targetEnd))
+                {
+                    const auto local{ target - targetBegin };
+                    accelerations[target] = settings.gravitationalConstant * glm::vec2{ fieldX[local], fieldY[local] };
+                    potentialEnergy -= static_cast<double>(masses[target]) * static_cast<double>(potentials[local]);
+                }
+                return potentialEnergy;
+            } };
+
+            const auto potentialEnergy{
+                parallelReduce(settings.jobSystem, 0uz, count, TARGET_GRAIN, 0.0, sumTargets, std::plus{})
+            };
+            // Every pair was counted from both ends
+            return 0.5 * potentialEnergy * settings.gravitationalConstant;
+        }
+    }
+
+    double DirectGravity::operator()(const ParticleSystem& particles, const std::span<glm::vec2> accelerations) const
+    {
+        return accumulateInDouble
+                   ? sumPairs<double>(particles, accelerations, *this)
+                   : sumPairs<float>(particles, accelerations, *this);
+    }
+
+    double HarmonicWell::operator()(const ParticleSystem& particles, const std::span<glm::vec2> accelerations) const noexcept
+    {
+        const auto positions{ particles.getPositions() };
+        const auto masses{ particles.getMasses() };
+
+        auto potentialEnergy{ 0.0 };
+        for (const auto index : std::views::iota(0uz, particles.size()))
+        {
+            accelerations[index] = -stiffness * positions[index];
+            potentialEnergy += 0.5 * stiffness * masses[index] * glm::dot(positions[index], positions[index]);
+        }
+        return potentialEnergy;
+    }
+
+    double computeKineticEnergy(const ParticleSystem& particles) noexcept
+    {
+        const auto velocities{ particles.getVelocities() };
+        const auto masses{ particles.getMasses() };
+
+        auto kineticEnergy{ 0.0 };
+        for (const auto index : std::views::iota(0uz, particles.size()))
+        {
+            kineticEnergy += 0.5 * masses[index] * glm::dot(velocities[index], velocities[index]);
+        }
+        return kineticEnergy;
+    }
+} // csv